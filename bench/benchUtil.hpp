@@ -0,0 +1,46 @@
+#ifndef BENCH_UTIL_HPP_
+#define BENCH_UTIL_HPP_
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// wall-clock seconds taken by f()
+template <typename F>
+double timeIt(F&& f) {
+  auto start = std::chrono::steady_clock::now();
+  f();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(stop - start).count();
+}
+
+// stop the optimiser from discarding a computed value
+template <typename T>
+void keep(const T& value) {
+#if defined(__GNUC__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &value;
+#endif
+}
+
+// the first command line argument divides every workload,
+// e.g. "poolBench 100" runs a hundredth of the default sizes
+inline long long scaled(long long n, int argc, char* argv[]) {
+  long long divisor = argc > 1 ? std::atoll(argv[1]) : 1;
+  if (divisor < 1) {
+    divisor = 1;
+  }
+  return n / divisor > 0 ? n / divisor : 1;
+}
+
+inline void report(const std::string& name, double seconds, long long ops) {
+  std::cout << std::left << std::setw(40) << name << std::right
+            << std::fixed << std::setprecision(3) << std::setw(10) << seconds << " s"
+            << std::setw(12) << std::setprecision(1) << ops / seconds / 1e6 << " Mops/s\n";
+}
+
+#endif    // BENCH_UTIL_HPP_
@@ -0,0 +1,53 @@
+#include <iostream>
+#include <list>
+#include <numeric>
+#include <vector>
+#include "benchUtil.hpp"
+#include "myList.hpp"
+
+int main(int argc, char* argv[]) {
+  const long long n = scaled(10'000'000, argc, argv);
+  std::vector<long long> source(static_cast<std::size_t>(n));
+  std::iota(source.begin(), source.end(), 0);
+
+  report("std::list range constructor", timeIt([&] {
+    std::list<long long> li(source.begin(), source.end());
+    keep(li.size());
+  }), n);
+  report("MyList push_back loop", timeIt([&] {
+    MyList<long long> li {};
+    for (long long x : source) {
+      li.push_back(x);
+    }
+    keep(li.size());
+  }), n);
+  report("MyList range constructor", timeIt([&] {
+    MyList<long long> li(source.begin(), source.end());
+    keep(li.size());
+  }), n);
+
+  // lists whose pools have a long free list: push_back reuses the
+  // scattered slots, a bulk insert takes one fresh block
+  auto churn = [&](MyList<long long>& li) {
+    li.assign(source.begin(), source.end());
+    for (auto it = li.begin(); it != li.end();) {
+      auto next = std::next(it);
+      li.erase(it);
+      it = next == li.end() ? next : std::next(next);
+    }
+  };
+  MyList<long long> churned {};
+  MyList<long long> refill {};
+  churn(churned);
+  churn(refill);
+  double pushTime = timeIt([&] {
+    for (long long x : source) {
+      churned.push_back(x);
+    }
+  });
+  report("push_back onto churned pool", pushTime, n);
+  report("insert(end, range) onto churned pool", timeIt([&] { refill.insert(refill.end(), source.begin(), source.end()); }), n);
+  report("  walk after push_back", timeIt([&] { keep(churned.accumulate(0LL)); }), churned.size());
+  report("  walk after insert(range)", timeIt([&] { keep(refill.accumulate(0LL)); }), refill.size());
+  return 0;
+}
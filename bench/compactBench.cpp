@@ -0,0 +1,67 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "benchUtil.hpp"
+#include "myList.hpp"
+
+double sumPass(const MyList<long long>& li) {
+  return timeIt([&] {
+    long long sum = 0;
+    for (long long x : li) {
+      sum += x;
+    }
+    keep(sum);
+  });
+}
+
+int main(int argc, char* argv[]) {
+  const long long n = scaled(5'000'000, argc, argv);
+  // churn: the nodes end up in an order unrelated to their addresses, as
+  // after a long run of inserts and erases at random positions
+  MyList<long long> li {};
+  {
+    MyList<long long> source {};
+    std::vector<MyList<long long>::Iterator> nodes {};
+    for (long long i = 0; i < n; ++i) {
+      source.push_back(i);
+      nodes.push_back(--source.end());
+    }
+    std::shuffle(nodes.begin(), nodes.end(), std::mt19937_64 {7});
+    for (auto it : nodes) {
+      li.splice(li.end(), source, it);
+    }
+  }
+  report("traversal, fragmented", sumPass(li), n);
+  report("compact()", timeIt([&] { li.compact(); }), n);
+  report("traversal, compacted", sumPass(li), n);
+
+  // the same again through compact_step, recording the slowest step
+  MyList<long long> shuffled {};
+  {
+    std::vector<MyList<long long>::Iterator> nodes {};
+    for (auto it = li.begin(); it != li.end(); ++it) {
+      nodes.push_back(it);
+    }
+    std::shuffle(nodes.begin(), nodes.end(), std::mt19937_64 {8});
+    for (auto it : nodes) {
+      shuffled.splice(shuffled.end(), li, it);
+    }
+  }
+  const int budget = 10'000;
+  double worst = 0;
+  int steps = 0;
+  double total = timeIt([&] {
+    bool done = false;
+    while (!done) {
+      double step = timeIt([&] { done = shuffled.compact_step(budget); });
+      worst = std::max(worst, step);
+      ++steps;
+    }
+  });
+  report("compact_step(10000) until done", total, n);
+  std::cout << steps << " steps, slowest " << std::fixed << std::setprecision(1) << worst * 1e6 << " us\n";
+  report("traversal, compacted by steps", sumPass(shuffled), n);
+  return 0;
+}
@@ -0,0 +1,109 @@
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "benchUtil.hpp"
+#include "lockCouplingList.hpp"
+#include "myList.hpp"
+
+// one mutex around a whole MyList, what LockCouplingList replaces
+class LockedList {
+ public:
+  using Iterator = MyList<int>::Iterator;
+
+  void push_back(int value) {
+    list_.push_back(value);
+  }
+
+  Iterator last() {
+    return --list_.end();
+  }
+
+  void insert(const Iterator& position, int value) {
+    std::lock_guard<std::mutex> lock {mutex_};
+    list_.insert(position, value);
+  }
+
+  void erase_before(const Iterator& position) {
+    std::lock_guard<std::mutex> lock {mutex_};
+    list_.erase(std::prev(position));
+  }
+
+ private:
+  std::mutex mutex_;
+  MyList<int> list_;
+};
+
+class Coupled {
+ public:
+  using Iterator = LockCouplingList<int>::Iterator;
+
+  void push_back(int value) {
+    list_.push_back(value);
+  }
+
+  Iterator last() {
+    return --list_.end();
+  }
+
+  void insert(const Iterator& position, int value) {
+    list_.insert(position, value);
+  }
+
+  void erase_before(const Iterator& position) {
+    list_.erase(std::prev(position));
+  }
+
+ private:
+  LockCouplingList<int> list_;
+};
+
+// every thread inserts in front of its own anchor and erases what it
+// inserted.  spread puts the anchors n / threads elements apart; otherwise
+// they are neighbours and each thread's edits touch the next one's anchor
+template <typename List>
+double anchored(int threads, long long total, int n, bool spread) {
+  List list {};
+  std::vector<typename List::Iterator> anchors {};
+  int gap = spread ? n / threads : 0;
+  for (int t = 0; t < threads; ++t) {
+    for (int i = 0; i < gap; ++i) {
+      list.push_back(i);
+    }
+    list.push_back(-1);
+    anchors.push_back(list.last());
+  }
+  long long perThread = total / threads;
+  return timeIt([&] {
+    std::vector<std::thread> workers {};
+    for (int t = 0; t < threads; ++t) {
+      workers.emplace_back([&list, &anchors, perThread, t] {
+        for (long long i = 0; i < perThread; ++i) {
+          list.insert(anchors[t], t);
+          list.erase_before(anchors[t]);
+        }
+      });
+    }
+    for (auto& w : workers) {
+      w.join();
+    }
+  });
+}
+
+int main(int argc, char* argv[]) {
+  const long long total = scaled(2'000'000, argc, argv);
+  const int n = 100'000;
+  std::cout << "hardware threads: " << std::thread::hardware_concurrency() << "\n";
+  for (bool spread : {true, false}) {
+    std::cout << (spread ? "anchors spread over the list\n" : "anchors next to each other\n");
+    for (int threads = 1; threads <= 32; threads *= 2) {
+      long long ops = total / threads * threads * 2;
+      std::string suffix = " x" + std::to_string(threads);
+      report("  LockCouplingList" + suffix, anchored<Coupled>(threads, total, n, spread), ops);
+      report("  mutex + MyList" + suffix, anchored<LockedList>(threads, total, n, spread), ops);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,46 @@
+#include <iostream>
+#include "benchUtil.hpp"
+#include "indexedList.hpp"
+#include "myList.hpp"
+
+template <typename List>
+double sumPasses(const List& li, int passes) {
+  return timeIt([&] {
+    for (int p = 0; p < passes; ++p) {
+      long long sum = 0;
+      for (int x : li) {
+        sum += x;
+      }
+      keep(sum);
+    }
+  });
+}
+
+int main(int argc, char* argv[]) {
+  const long long maxN = scaled(100'000'000, argc, argv);
+  const int passes = 3;
+  std::cout << "bytes per element: MyList<int>::Node " << sizeof(MyList<int>::Node)
+            << " (pooled; +16 or so per node with one malloc each), IndexedList<int>::Slot "
+            << sizeof(IndexedList<int>::Slot) << "\n";
+  for (long long n = scaled(1'000'000, argc, argv); n <= maxN; n *= 10) {
+    std::cout << "n = " << n << "\n";
+    {
+      MyList<int> li {};
+      for (long long i = 0; i < n; ++i) {
+        li.push_back(static_cast<int>(i));
+      }
+      std::cout << "  MyList<int>       ~" << n * sizeof(MyList<int>::Node) / (1 << 20) << " MiB\n";
+      report("  MyList<int> traversal", sumPasses(li, passes), n * passes);
+    }
+    {
+      IndexedList<int> li {};
+      li.reserve(static_cast<int>(n));
+      for (long long i = 0; i < n; ++i) {
+        li.push_back(static_cast<int>(i));
+      }
+      std::cout << "  IndexedList<int>   " << li.memoryBytes() / (1 << 20) << " MiB\n";
+      report("  IndexedList<int> traversal", sumPasses(li, passes), n * passes);
+    }
+  }
+  return 0;
+}
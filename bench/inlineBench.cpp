@@ -0,0 +1,75 @@
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <new>
+#include "benchUtil.hpp"
+#include "myList.hpp"
+
+// every allocation in the program goes through these, so the count is exact
+static long long allocations = 0;
+
+void* operator new(std::size_t size) {
+  ++allocations;
+  if (void* p = std::malloc(size > 0 ? size : 1)) {
+    return p;
+  }
+  throw std::bad_alloc {};
+}
+
+void* operator new(std::size_t size, std::align_val_t align) {
+  ++allocations;
+  std::size_t alignment = static_cast<std::size_t>(align);
+  if (void* p = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)) {
+    return p;
+  }
+  throw std::bad_alloc {};
+}
+
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+  std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+  std::free(p);
+}
+
+// build a list of 1 to 4 elements, read it and let it go, lists times over
+template <typename List>
+void shortLived(const std::string& name, long long lists) {
+  long long before = allocations;
+  long long sum = 0;
+  double seconds = timeIt([&] {
+    for (long long i = 0; i < lists; ++i) {
+      List li {};
+      int length = static_cast<int>(i % 4) + 1;
+      for (int k = 0; k < length; ++k) {
+        li.push_back(k);
+      }
+      for (int x : li) {
+        sum += x;
+      }
+    }
+  });
+  keep(sum);
+  report(name, seconds, lists);
+  std::cout << "  " << std::setprecision(2) << static_cast<double>(allocations - before) / lists
+            << " allocations per list\n";
+}
+
+int main(int argc, char* argv[]) {
+  const long long lists = scaled(5'000'000, argc, argv);
+  shortLived<std::list<int>>("std::list<int>", lists);
+  shortLived<MyList<int>>("MyList<int>", lists);
+  shortLived<MyList<int, 2>>("MyList<int, 2>", lists);
+  shortLived<MyList<int, 4>>("MyList<int, 4>", lists);
+  std::cout << "sizeof MyList<int> " << sizeof(MyList<int>) << ", MyList<int, 4> " << sizeof(MyList<int, 4>) << "\n";
+  return 0;
+}
@@ -0,0 +1,53 @@
+#include <iostream>
+#include "benchUtil.hpp"
+#include "baselineList.hpp"
+#include "myList.hpp"
+
+// `it != li.end()` loop, the pattern of the loopWithIterators test
+template <typename List>
+double iteratorLoop(List& li, long long passes) {
+  return timeIt([&] {
+    for (long long p = 0; p < passes; ++p) {
+      long long sum = 0;
+      for (auto it = li.begin(); it != li.end(); ++it) {
+        sum += *it;
+      }
+      keep(sum);
+    }
+  });
+}
+
+template <typename List>
+double rangeFor(List& li, long long passes) {
+  return timeIt([&] {
+    for (long long p = 0; p < passes; ++p) {
+      long long sum = 0;
+      for (int x : li) {
+        sum += x;
+      }
+      keep(sum);
+    }
+  });
+}
+
+int main(int argc, char* argv[]) {
+  const long long work = scaled(200'000'000, argc, argv);
+  for (long long n : {1'000LL, 100'000LL, 10'000'000LL}) {
+    n = n < work ? n : work;
+    long long passes = work / n;
+    baseline::MyList<int> before {};
+    MyList<int> after {};
+    for (long long i = 0; i < n; ++i) {
+      before.push_back(static_cast<int>(i));
+      after.push_back(static_cast<int>(i));
+    }
+    std::cout << "n = " << n << ", " << passes << " passes\n";
+    report("  it != end()  baseline::MyList<int>", iteratorLoop(before, passes), n * passes);
+    report("  it != end()  MyList<int>", iteratorLoop(after, passes), n * passes);
+    report("  range-for    baseline::MyList<int>", rangeFor(before, passes), n * passes);
+    report("  range-for    MyList<int>", rangeFor(after, passes), n * passes);
+    const MyList<int>& view = after;
+    report("  const range-for MyList<int>", rangeFor(view, passes), n * passes);
+  }
+  return 0;
+}
@@ -0,0 +1,73 @@
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include "benchUtil.hpp"
+#include "myList.hpp"
+
+template <std::size_t Bytes, bool Split>
+struct Blob {
+  long long key;
+  unsigned char rest[Bytes - sizeof(long long)];
+};
+
+template <std::size_t Bytes>
+struct ListLayout<Blob<Bytes, true>> {
+  static constexpr bool split = true;
+};
+
+// link-only work (counting, seeking, splicing) against a walk that reads
+// every element
+template <std::size_t Bytes, bool Split>
+void run(long long n, int passes) {
+  using Element = Blob<Bytes, Split>;
+  const std::string name = std::string(Split ? "  split " : "  inline") + " " + std::to_string(Bytes) + " B";
+  MyList<Element> li {};
+  for (long long i = 0; i < n; ++i) {
+    li.emplace_back().key = i;
+  }
+  report(name + " count", timeIt([&] {
+    for (int p = 0; p < passes; ++p) {
+      keep(std::distance(li.begin(), li.end()));
+    }
+  }), n * passes);
+  report(name + " seek to middle", timeIt([&] {
+    for (int p = 0; p < passes; ++p) {
+      keep(&*std::next(li.begin(), n / 2));
+    }
+  }), n / 2 * passes);
+  report(name + " splice odd out+back", timeIt([&] {
+    for (int p = 0; p < passes; ++p) {
+      MyList<Element> odd {};
+      for (auto it = li.begin(); it != li.end();) {
+        auto next = std::next(it);
+        if (next == li.end()) {
+          break;
+        }
+        it = std::next(next);
+        odd.splice(odd.end(), li, next);
+      }
+      li.splice(li.end(), odd);
+    }
+  }), n * passes);
+  report(name + " sum keys", timeIt([&] {
+    for (int p = 0; p < passes; ++p) {
+      long long sum = 0;
+      for (const auto& e : li) {
+        sum += e.key;
+      }
+      keep(sum);
+    }
+  }), n * passes);
+}
+
+int main(int argc, char* argv[]) {
+  const int passes = 5;
+  std::cout << "node bytes: inline 256 B " << sizeof(MyList<Blob<256, false>>::Node) << ", split 256 B "
+            << sizeof(MyList<Blob<256, true>>::Node) << "\n";
+  run<256, false>(scaled(400'000, argc, argv), passes);
+  run<256, true>(scaled(400'000, argc, argv), passes);
+  run<1024, false>(scaled(100'000, argc, argv), passes);
+  run<1024, true>(scaled(100'000, argc, argv), passes);
+  return 0;
+}
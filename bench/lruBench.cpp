@@ -0,0 +1,120 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "benchUtil.hpp"
+#include "lruCache.hpp"
+
+// the hand-rolled cache LruCache replaces: std::list in recency order plus
+// an unordered_map from key to list iterator
+class StdLru {
+ public:
+  explicit StdLru(std::size_t capacity) : capacity_ {capacity} {}
+
+  long long* get(long long key) {
+    auto found = index_.find(key);
+    if (found == index_.end()) {
+      return nullptr;
+    }
+    order_.splice(order_.begin(), order_, found->second);
+    return &found->second->second;
+  }
+
+  void put(long long key, long long value) {
+    auto found = index_.find(key);
+    if (found != index_.end()) {
+      found->second->second = value;
+      order_.splice(order_.begin(), order_, found->second);
+      return;
+    }
+    if (index_.size() == capacity_) {
+      index_.erase(order_.back().first);
+      order_.pop_back();
+    }
+    order_.emplace_front(key, value);
+    index_.emplace(key, order_.begin());
+  }
+
+ private:
+  std::size_t capacity_;
+  std::list<std::pair<long long, long long>> order_;
+  std::unordered_map<long long, std::list<std::pair<long long, long long>>::iterator> index_;
+};
+
+// time each hit on its own and print p50/p99; the figures include the
+// cost of reading the clock twice
+template <typename Cache>
+void hitLatency(const std::string& name, Cache& cache, const std::vector<long long>& keys) {
+  std::vector<double> ns {};
+  ns.reserve(keys.size());
+  long long sum = 0;
+  for (long long key : keys) {
+    auto start = std::chrono::steady_clock::now();
+    long long* value = cache.get(key);
+    auto stop = std::chrono::steady_clock::now();
+    sum += *value;
+    ns.push_back(std::chrono::duration<double, std::nano>(stop - start).count());
+  }
+  keep(sum);
+  std::sort(ns.begin(), ns.end());
+  std::cout << "  " << std::left << std::setw(30) << name << std::right << std::fixed << std::setprecision(0)
+            << " hit p50 " << std::setw(6) << ns[ns.size() / 2] << " ns   p99 " << std::setw(6)
+            << ns[ns.size() * 99 / 100] << " ns\n";
+}
+
+template <typename Cache>
+void churn(const std::string& name, Cache& cache, const std::vector<long long>& keys) {
+  double seconds = timeIt([&] {
+    long long hits = 0;
+    for (long long key : keys) {
+      if (cache.get(key) != nullptr) {
+        ++hits;
+      }
+      else {
+        cache.put(key, key);
+      }
+    }
+    keep(hits);
+  });
+  report("  " + name + " get/put churn", seconds, static_cast<long long>(keys.size()));
+}
+
+int main(int argc, char* argv[]) {
+  const long long ops = scaled(5'000'000, argc, argv);
+  for (long long capacity = scaled(10'000, argc, argv); capacity <= scaled(1'000'000, argc, argv); capacity *= 10) {
+    std::cout << "capacity = " << capacity << "\n";
+    std::mt19937_64 mt {1};
+    std::vector<long long> hits {};
+    for (long long i = 0; i < ops; ++i) {
+      hits.push_back(static_cast<long long>(mt() % capacity));
+    }
+    // twice the capacity in keys, so about half the lookups miss
+    std::vector<long long> mixed {};
+    for (long long i = 0; i < ops; ++i) {
+      mixed.push_back(static_cast<long long>(mt() % (capacity * 2)));
+    }
+    {
+      LruCache<long long, long long> cache {static_cast<std::size_t>(capacity)};
+      for (long long k = 0; k < capacity; ++k) {
+        cache.put(k, k);
+      }
+      hitLatency("LruCache", cache, hits);
+      churn("LruCache", cache, mixed);
+    }
+    {
+      StdLru cache {static_cast<std::size_t>(capacity)};
+      for (long long k = 0; k < capacity; ++k) {
+        cache.put(k, k);
+      }
+      hitLatency("std::list + unordered_map", cache, hits);
+      churn("std::list + unordered_map", cache, mixed);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,78 @@
+#include <iostream>
+#include <random>
+#include <vector>
+#include "benchUtil.hpp"
+#include "myList.hpp"
+#include "orderedList.hpp"
+
+// without labels: walk forward from a until b or the end turns up
+bool walkBefore(MyList<long long>& li, MyList<long long>::Iterator a, MyList<long long>::Iterator b) {
+  for (; a != li.end(); ++a) {
+    if (a == b) {
+      return true;
+    }
+  }
+  return false;
+}
+
+int main(int argc, char* argv[]) {
+  const long long n = scaled(10'000'000, argc, argv);
+  std::mt19937_64 mt {17};
+
+  OrderedList<long long> ordered {};
+  std::vector<OrderedList<long long>::Iterator> its {};
+  its.reserve(static_cast<std::size_t>(n + n / 2));
+  report("OrderedList push_back", timeIt([&] {
+    for (long long i = 0; i < n; ++i) {
+      ordered.push_back(i);
+      its.push_back(std::prev(ordered.end()));
+    }
+  }), n);
+
+  // half inserts in front of random elements, half random comparisons
+  long long found = 0;
+  report("mixed insert / before()", timeIt([&] {
+    for (long long i = 0; i < n; ++i) {
+      auto a = its[mt() % its.size()];
+      if (i % 2 == 0) {
+        its.push_back(ordered.insert(a, i));
+      }
+      else {
+        found += ordered.before(a, its[mt() % its.size()]);
+      }
+    }
+  }), n);
+  keep(found);
+
+  // every insert in the same gap: splits and group relabelling all the time
+  auto spot = its[its.size() / 2];
+  const long long hot = n / 10;
+  report("inserts at one spot", timeIt([&] {
+    for (long long i = 0; i < hot; ++i) {
+      ordered.insert(spot, i);
+    }
+  }), hot);
+
+  report("before() on random pairs", timeIt([&] {
+    for (long long i = 0; i < n; ++i) {
+      found += ordered.before(its[mt() % its.size()], its[mt() % its.size()]);
+    }
+  }), n);
+  keep(found);
+
+  // the walk is O(distance), so only a handful of queries
+  MyList<long long> plain {};
+  std::vector<MyList<long long>::Iterator> plainIts {};
+  for (long long i = 0; i < n; ++i) {
+    plain.push_back(i);
+    plainIts.push_back(std::prev(plain.end()));
+  }
+  const long long walks = 20;
+  report("MyList walk to compare", timeIt([&] {
+    for (long long i = 0; i < walks; ++i) {
+      found += walkBefore(plain, plainIts[mt() % plainIts.size()], plainIts[mt() % plainIts.size()]);
+    }
+  }), walks);
+  keep(found);
+  return 0;
+}
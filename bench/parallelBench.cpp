@@ -0,0 +1,39 @@
+#include <iostream>
+#include <thread>
+#include "benchUtil.hpp"
+#include "myList.hpp"
+#include "parallelList.hpp"
+
+// a few multiplies per element, so the walk is not purely memory bound
+unsigned long long mix(unsigned long long x) {
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdULL;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ULL;
+  return x ^ (x >> 33);
+}
+
+int main(int argc, char* argv[]) {
+  const long long n = scaled(20'000'000, argc, argv);
+  MyList<unsigned long long> li {};
+  for (long long i = 0; i < n; ++i) {
+    li.push_back(static_cast<unsigned long long>(i));
+  }
+  std::cout << std::thread::hardware_concurrency() << " hardware threads\n";
+  report("serial accumulate", timeIt([&] {
+    keep(li.accumulate(0ULL, [](unsigned long long a, unsigned long long x) { return a + mix(x); }));
+  }), n);
+  report("split_points(32), cached", timeIt([&] { keep(li.split_points(32).size()); }), n);
+  for (int threads : {1, 2, 4, 8, 16, 32}) {
+    // the caller is one of the threads
+    ThreadPool pool {threads - 1};
+    std::cout << threads << " threads\n";
+    report("  parallel_reduce", timeIt([&] {
+      keep(parallel_reduce(pool, li, 0ULL, std::plus<>(), mix));
+    }), n);
+    report("  parallel_for_each", timeIt([&] {
+      parallel_for_each(pool, li, [](unsigned long long& x) { x = mix(x); });
+    }), n);
+  }
+  return 0;
+}
@@ -0,0 +1,54 @@
+#include <iostream>
+#include <list>
+#include <string>
+#include "benchUtil.hpp"
+#include "baselineList.hpp"
+#include "myList.hpp"
+
+// queue churn: keep `depth` elements live and do `cycles` push_back/pop_front pairs
+template <typename List>
+double queueChurn(long long cycles, int depth) {
+  List li {};
+  for (int i = 0; i < depth; ++i) {
+    li.push_back(i);
+  }
+  return timeIt([&] {
+    for (long long i = 0; i < cycles; ++i) {
+      li.push_back(static_cast<int>(i));
+      li.pop_front();
+    }
+    keep(li.front());
+  });
+}
+
+// burst churn: fill to `depth`, drain, repeat until `cycles` push/pop pairs are done
+template <typename List>
+double burstChurn(long long cycles, int depth) {
+  List li {};
+  return timeIt([&] {
+    for (long long done = 0; done < cycles; done += depth) {
+      for (int i = 0; i < depth; ++i) {
+        li.push_back(i);
+      }
+      keep(li.back());
+      for (int i = 0; i < depth; ++i) {
+        li.pop_back();
+      }
+    }
+  });
+}
+
+int main(int argc, char* argv[]) {
+  const long long cycles = scaled(10'000'000, argc, argv);
+  const int depth = 1000;
+  std::cout << cycles << " push/pop cycles, depth " << depth << "\n";
+
+  report("queue churn  baseline::MyList<int>", queueChurn<baseline::MyList<int>>(cycles, depth), cycles);
+  report("queue churn  MyList<int>", queueChurn<MyList<int>>(cycles, depth), cycles);
+  report("queue churn  std::list<int>", queueChurn<std::list<int>>(cycles, depth), cycles);
+
+  report("burst churn  baseline::MyList<int>", burstChurn<baseline::MyList<int>>(cycles, depth), cycles);
+  report("burst churn  MyList<int>", burstChurn<MyList<int>>(cycles, depth), cycles);
+  report("burst churn  std::list<int>", burstChurn<std::list<int>>(cycles, depth), cycles);
+  return 0;
+}
@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "benchUtil.hpp"
+#include "myList.hpp"
+
+template <bool Split>
+struct Record {
+  long long key;
+  unsigned char rest[248];
+};
+
+template <>
+struct ListLayout<Record<true>> {
+  static constexpr bool split = true;
+};
+
+// list order unrelated to memory order, as after long insert/erase churn:
+// the nodes are allocated in sequence and then spliced into a random order
+template <typename T, typename Make>
+MyList<T> scattered(long long n, Make make) {
+  MyList<T> source {};
+  std::vector<typename MyList<T>::Iterator> nodes {};
+  nodes.reserve(n);
+  for (long long i = 0; i < n; ++i) {
+    source.push_back(make(i));
+    nodes.push_back(--source.end());
+  }
+  std::shuffle(nodes.begin(), nodes.end(), std::mt19937_64 {42});
+  MyList<T> li {};
+  for (auto it : nodes) {
+    li.splice(li.end(), source, it);
+  }
+  return li;
+}
+
+template <typename T, typename Key>
+void compare(const std::string& name, const MyList<T>& li, Key key) {
+  long long n = li.size();
+  report(name + " range-for", timeIt([&] {
+    long long sum = 0;
+    for (const auto& x : li) {
+      sum += key(x);
+    }
+    keep(sum);
+  }), n);
+  for (int distance : {0, 4, 8, 16, 32}) {
+    report(name + " accumulate d=" + std::to_string(distance), timeIt([&] {
+      keep(li.accumulate(0LL, [&](long long s, const T& x) { return s + key(x); }, distance));
+    }), n);
+  }
+  report(name + " range-for count", timeIt([&] {
+    int count = 0;
+    for (const auto& x : li) {
+      count += key(x) % 3 == 0 ? 1 : 0;
+    }
+    keep(count);
+  }), n);
+  report(name + " count_if, both ends", timeIt([&] {
+    keep(li.count_if([&](const T& x) { return key(x) % 3 == 0; }));
+  }), n);
+}
+
+int main(int argc, char* argv[]) {
+  const long long n = scaled(10'000'000, argc, argv);
+  {
+    auto li = scattered<long long>(n, [](long long i) { return i; });
+    compare("  int64", li, [](long long x) { return x; });
+  }
+  {
+    const long long big = scaled(1'000'000, argc, argv);
+    auto li = scattered<Record<false>>(big, [](long long i) { return Record<false> {i, {}}; });
+    compare("  256 B inline", li, [](const Record<false>& r) { return r.key; });
+  }
+  {
+    const long long big = scaled(1'000'000, argc, argv);
+    auto li = scattered<Record<true>>(big, [](long long i) { return Record<true> {i, {}}; });
+    compare("  256 B split", li, [](const Record<true>& r) { return r.key; });
+  }
+  return 0;
+}
@@ -0,0 +1,70 @@
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "benchUtil.hpp"
+#include "concurrentQueue.hpp"
+#include "myList.hpp"
+
+// the global-mutex queue ConcurrentQueue replaces
+class LockedList {
+ public:
+  void push_back(long long value) {
+    std::lock_guard<std::mutex> lock {mutex_};
+    list_.push_back(value);
+  }
+
+  bool pop_front(long long& out) {
+    std::lock_guard<std::mutex> lock {mutex_};
+    if (list_.empty()) {
+      return false;
+    }
+    out = list_.front();
+    list_.pop_front();
+    return true;
+  }
+
+ private:
+  std::mutex mutex_;
+  MyList<long long> list_;
+};
+
+// every thread alternates a push with a pop, the usual pairwise queue
+// benchmark: the queue stays short and head and tail are both contended
+template <typename Queue>
+double pairs(int threads, long long total) {
+  Queue queue {};
+  long long perThread = total / threads;
+  return timeIt([&] {
+    std::vector<std::thread> workers {};
+    for (int t = 0; t < threads; ++t) {
+      workers.emplace_back([&queue, perThread, t] {
+        long long sum = 0;
+        long long out = 0;
+        for (long long i = 0; i < perThread; ++i) {
+          queue.push_back(i + t);
+          if (queue.pop_front(out)) {
+            sum += out;
+          }
+        }
+        keep(sum);
+      });
+    }
+    for (auto& w : workers) {
+      w.join();
+    }
+  });
+}
+
+int main(int argc, char* argv[]) {
+  const long long total = scaled(4'000'000, argc, argv);
+  std::cout << "hardware threads: " << std::thread::hardware_concurrency() << "\n";
+  for (int threads = 1; threads <= 64; threads *= 2) {
+    std::cout << "threads = " << threads << "\n";
+    long long ops = total / threads * threads * 2;
+    report("  ConcurrentQueue push+pop", pairs<ConcurrentQueue<long long>>(threads, total), ops);
+    report("  mutex + MyList push+pop", pairs<LockedList>(threads, total), ops);
+  }
+  return 0;
+}
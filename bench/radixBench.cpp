@@ -0,0 +1,35 @@
+#include <iostream>
+#include <random>
+#include <vector>
+#include "benchUtil.hpp"
+#include "myList.hpp"
+#include "parallelList.hpp"
+
+int main(int argc, char* argv[]) {
+  const long long n = scaled(20'000'000, argc, argv);
+  std::mt19937_64 mt {3};
+  std::vector<unsigned long long> wide(static_cast<std::size_t>(n));
+  std::vector<unsigned long long> narrow(static_cast<std::size_t>(n));
+  for (std::size_t i = 0; i < wide.size(); ++i) {
+    wide[i] = mt();
+    narrow[i] = wide[i] >> 40;
+  }
+  std::cout << n << " unsigned long long elements, " << std::thread::hardware_concurrency()
+            << " hardware threads\n";
+
+  auto measure = [&](const std::string& name, const std::vector<unsigned long long>& values, auto sort) {
+    MyList<unsigned long long> li(values.begin(), values.end());
+    report(name, timeIt([&] { sort(li); }), n);
+    keep(li.front());
+  };
+  measure("MyList::sort", wide, [](auto& li) { li.sort(); });
+  for (int threads : {1, 2, 4, 8}) {
+    ThreadPool pool {threads - 1};
+    measure("parallel_sort, " + std::to_string(threads) + " threads", wide,
+            [&](auto& li) { parallel_sort(pool, li); });
+  }
+  measure("radix_sort, 64-bit keys", wide, [](auto& li) { li.radix_sort(); });
+  measure("MyList::sort, 24-bit keys", narrow, [](auto& li) { li.sort(); });
+  measure("radix_sort, 24-bit keys", narrow, [](auto& li) { li.radix_sort(); });
+  return 0;
+}
@@ -0,0 +1,119 @@
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "benchUtil.hpp"
+#include "myList.hpp"
+#include "rcuList.hpp"
+
+// the reader-locked MyList RcuList replaces
+class SharedLockedList {
+ public:
+  explicit SharedLockedList(int n) {
+    for (int i = 0; i < n; ++i) {
+      list_.push_back(i);
+    }
+  }
+
+  long long sum() {
+    std::shared_lock<std::shared_mutex> lock {mutex_};
+    long long total = 0;
+    for (int v : list_) {
+      total += v;
+    }
+    return total;
+  }
+
+  void rotate() {
+    std::unique_lock<std::shared_mutex> lock {mutex_};
+    int v = list_.front();
+    list_.pop_front();
+    list_.push_back(v);
+  }
+
+ private:
+  std::shared_mutex mutex_;
+  MyList<int> list_;
+};
+
+class Rcu {
+ public:
+  explicit Rcu(int n) {
+    for (int i = 0; i < n; ++i) {
+      list_.push_back(i);
+    }
+  }
+
+  long long sum() {
+    long long total = 0;
+    for (int v : list_.read()) {
+      total += v;
+    }
+    return total;
+  }
+
+  void rotate() {
+    int v = *list_.begin();
+    list_.pop_front();
+    list_.push_back(v);
+  }
+
+ private:
+  RcuList<int> list_;
+};
+
+// readers walk the whole list as fast as they can for a fixed time while
+// one writer changes it every writeMicros; returns walks per second
+template <typename List>
+double readRate(int readers, int n, int writeMicros, double seconds) {
+  List list {n};
+  std::atomic<bool> done {false};
+  std::atomic<long long> walks {0};
+  std::vector<std::thread> threads {};
+  for (int r = 0; r < readers; ++r) {
+    threads.emplace_back([&] {
+      long long mine = 0;
+      long long total = 0;
+      while (!done.load(std::memory_order_relaxed)) {
+        total += list.sum();
+        ++mine;
+      }
+      keep(total);
+      walks.fetch_add(mine);
+    });
+  }
+  threads.emplace_back([&] {
+    while (!done.load(std::memory_order_relaxed)) {
+      list.rotate();
+      std::this_thread::sleep_for(std::chrono::microseconds(writeMicros));
+    }
+  });
+  std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+  done.store(true);
+  for (auto& t : threads) {
+    t.join();
+  }
+  return walks.load() / seconds;
+}
+
+int main(int argc, char* argv[]) {
+  // one second per measurement, divided like every other workload
+  const double seconds = scaled(1000, argc, argv) / 1000.0;
+  const int n = 100;
+  const int writeMicros = 1000;
+  std::cout << "hardware threads: " << std::thread::hardware_concurrency() << ", " << n
+            << " elements, one write every " << writeMicros << " us\n";
+  for (int readers = 1; readers <= 32; readers *= 2) {
+    double rcu = readRate<Rcu>(readers, n, writeMicros, seconds);
+    double locked = readRate<SharedLockedList>(readers, n, writeMicros, seconds);
+    std::cout << "  readers = " << std::setw(2) << readers << std::fixed << std::setprecision(2)
+              << "   RcuList " << std::setw(8) << rcu / 1e6 << " M walks/s   shared_mutex + MyList "
+              << std::setw(8) << locked / 1e6 << " M walks/s\n";
+  }
+  return 0;
+}
@@ -0,0 +1,82 @@
+#include <iostream>
+#include <list>
+#include <random>
+#include <vector>
+#include "benchUtil.hpp"
+#include "myList.hpp"
+
+int main(int argc, char* argv[]) {
+  const long long n = scaled(10'000'000, argc, argv);
+  std::mt19937_64 mt {23};
+  // odd values are removed: half of them, in no pattern a branch predictor
+  // could learn
+  std::vector<long long> source(static_cast<std::size_t>(n));
+  for (auto& v : source) {
+    v = static_cast<long long>(mt() >> 1);
+  }
+  auto odd = [](long long v) { return v % 2 != 0; };
+
+  {
+    std::list<long long> li(source.begin(), source.end());
+    report("std::list::remove_if", timeIt([&] { keep(li.remove_if(odd)); }), n);
+  }
+  {
+    MyList<long long> li(source.begin(), source.end());
+    report("MyList erase in a loop", timeIt([&] {
+      for (auto it = li.begin(); it != li.end();) {
+        auto next = std::next(it);
+        if (odd(*it)) {
+          li.erase(it);
+        }
+        it = next;
+      }
+    }), n);
+    keep(li.size());
+  }
+  {
+    MyList<long long> li(source.begin(), source.end());
+    report("MyList::remove_if", timeIt([&] { keep(li.remove_if(odd)); }), n);
+  }
+
+  // runs of two equal neighbours
+  std::vector<long long> pairs {};
+  pairs.reserve(source.size());
+  for (std::size_t i = 0; i < source.size(); ++i) {
+    pairs.push_back(source[i / 2 * 2]);
+  }
+  {
+    MyList<long long> li(pairs.begin(), pairs.end());
+    report("MyList erase duplicates in a loop", timeIt([&] {
+      for (auto it = li.begin(); it != li.end();) {
+        auto next = std::next(it);
+        if (next != li.end() && *next == *it) {
+          li.erase(next);
+        }
+        else {
+          it = next;
+        }
+      }
+    }), n);
+    keep(li.size());
+  }
+  {
+    MyList<long long> li(pairs.begin(), pairs.end());
+    report("MyList::unique", timeIt([&] { keep(li.unique()); }), n);
+  }
+
+  {
+    MyList<long long> li(source.begin(), source.end());
+    auto middle = std::next(li.begin(), li.size() / 2);
+    report("MyList erase back half in a loop", timeIt([&] {
+      while (middle != li.end()) {
+        li.erase(middle++);
+      }
+    }), n / 2);
+  }
+  {
+    MyList<long long> li(source.begin(), source.end());
+    auto middle = std::next(li.begin(), li.size() / 2);
+    report("MyList::erase(middle, end)", timeIt([&] { li.erase(middle, li.end()); }), n / 2);
+  }
+  return 0;
+}
@@ -0,0 +1,105 @@
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "benchUtil.hpp"
+#include "concurrentSet.hpp"
+#include "myList.hpp"
+
+// the sorted MyList behind a mutex that ConcurrentSet replaces
+class LockedSet {
+ public:
+  bool insert(int value) {
+    std::lock_guard<std::mutex> lock {mutex_};
+    auto it = lowerBound(value);
+    if (it != list_.end() && *it == value) {
+      return false;
+    }
+    list_.insert(it, value);
+    return true;
+  }
+
+  bool erase(int value) {
+    std::lock_guard<std::mutex> lock {mutex_};
+    auto it = lowerBound(value);
+    if (it == list_.end() || *it != value) {
+      return false;
+    }
+    list_.erase(it);
+    return true;
+  }
+
+  bool contains(int value) {
+    std::lock_guard<std::mutex> lock {mutex_};
+    auto it = lowerBound(value);
+    return it != list_.end() && *it == value;
+  }
+
+ private:
+  MyList<int>::Iterator lowerBound(int value) {
+    auto it = list_.begin();
+    while (it != list_.end() && *it < value) {
+      ++it;
+    }
+    return it;
+  }
+
+  std::mutex mutex_;
+  MyList<int> list_;
+};
+
+// readPercent of operations are lookups, the rest split evenly between
+// inserts and erases of random keys, starting from a half full set
+template <typename Set>
+double mix(int threads, long long total, int range, int readPercent) {
+  Set set {};
+  for (int key = 0; key < range; key += 2) {
+    set.insert(key);
+  }
+  long long perThread = total / threads;
+  return timeIt([&] {
+    std::vector<std::thread> workers {};
+    for (int t = 0; t < threads; ++t) {
+      workers.emplace_back([&set, perThread, range, readPercent, t] {
+        std::mt19937 mt {static_cast<unsigned>(t + 1)};
+        long long hits = 0;
+        for (long long i = 0; i < perThread; ++i) {
+          int key = static_cast<int>(mt() % range);
+          int op = static_cast<int>(mt() % 100);
+          if (op < readPercent) {
+            hits += set.contains(key);
+          }
+          else if ((op - readPercent) % 2 == 0) {
+            hits += set.insert(key);
+          }
+          else {
+            hits += set.erase(key);
+          }
+        }
+        keep(hits);
+      });
+    }
+    for (auto& w : workers) {
+      w.join();
+    }
+  });
+}
+
+int main(int argc, char* argv[]) {
+  const long long total = scaled(2'000'000, argc, argv);
+  const int range = 1000;
+  std::cout << "hardware threads: " << std::thread::hardware_concurrency() << ", keys: " << range << "\n";
+  for (int readPercent : {90, 50}) {
+    int writePercent = (100 - readPercent) / 2;
+    std::cout << readPercent << "/" << writePercent << "/" << writePercent << " contains/insert/erase\n";
+    for (int threads = 1; threads <= 64; threads *= 2) {
+      long long ops = total / threads * threads;
+      std::string suffix = " x" + std::to_string(threads);
+      report("  ConcurrentSet" + suffix, mix<ConcurrentSet<int>>(threads, total, range, readPercent), ops);
+      report("  mutex + sorted MyList" + suffix, mix<LockedSet>(threads, total, range, readPercent), ops);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,62 @@
+#include <algorithm>
+#include <iostream>
+#include <mutex>
+#include "benchUtil.hpp"
+#include "myList.hpp"
+#include "persistentList.hpp"
+
+// A shared state list that one in every 16 requests changes at the front
+// under a lock.  Every other request takes a snapshot of it under the lock,
+// lets go of the lock and then reads the snapshot's first few elements.
+// Copying MyList makes the snapshot O(n) and holds the lock for all of it;
+// a PersistentList snapshot is one increment.
+template <typename List, typename Snapshot, typename Update>
+double serve(List& state, long long requests, Snapshot snapshot, Update update) {
+  std::mutex lock {};
+  long long sum = 0;
+  double seconds = timeIt([&] {
+    for (long long r = 0; r < requests; ++r) {
+      if (r % 16 == 0) {
+        std::lock_guard<std::mutex> guard {lock};
+        update(state, r);
+        continue;
+      }
+      auto copy = [&] {
+        std::lock_guard<std::mutex> guard {lock};
+        return snapshot(state);
+      }();
+      int read = 0;
+      for (auto it = copy.begin(); it != copy.end() && read < 8; ++it, ++read) {
+        sum += *it;
+      }
+    }
+  });
+  keep(sum);
+  return seconds;
+}
+
+int main(int argc, char* argv[]) {
+  for (int length : {10, 100, 1000, 10000}) {
+    // fewer requests for longer lists, or the copying side takes minutes
+    const long long requests = scaled(std::max(20'000'000 / length, 10'000), argc, argv);
+    std::cout << length << " elements\n";
+
+    MyList<long long> mutableState {};
+    for (int i = 0; i < length; ++i) {
+      mutableState.push_back(i);
+    }
+    report("  MyList copy", serve(mutableState, requests, [](const MyList<long long>& s) { return s; },
+                                  [](MyList<long long>& s, long long r) {
+                                    s.pop_front();
+                                    s.push_front(r);
+                                  }),
+           requests);
+
+    PersistentList<long long> sharedState(mutableState.begin(), mutableState.end());
+    report("  PersistentList snapshot",
+           serve(sharedState, requests, [](const PersistentList<long long>& s) { return s; },
+                 [](PersistentList<long long>& s, long long r) { s = s.pop_front().push_front(r); }),
+           requests);
+  }
+  return 0;
+}
@@ -0,0 +1,59 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "benchUtil.hpp"
+#include "myList.hpp"
+
+// random 16 character strings, one past the small-string buffer so every
+// copy has to allocate
+MyList<std::string> randomStrings(long long n) {
+  std::mt19937 mt {1};
+  std::uniform_int_distribution<int> letter {'a', 'z'};
+  MyList<std::string> li {};
+  for (long long i = 0; i < n; ++i) {
+    std::string s(16, ' ');
+    for (auto& c : s) {
+      c = static_cast<char>(letter(mt));
+    }
+    li.push_back(std::move(s));
+  }
+  return li;
+}
+
+// what callers did before MyList::sort: copy out, sort, rebuild
+void vectorRoundTrip(MyList<std::string>& li) {
+  std::vector<std::string> v {};
+  v.reserve(li.size());
+  for (const auto& x : li) {
+    v.push_back(x);
+  }
+  std::sort(v.begin(), v.end());
+  li.clear();
+  for (const auto& x : v) {
+    li.push_back(x);
+  }
+}
+
+int main(int argc, char* argv[]) {
+  const long long n = scaled(10'000'000, argc, argv);
+  std::cout << n << " std::string elements\n";
+  {
+    MyList<std::string> li = randomStrings(n);
+    report("vector round trip (std::sort)", timeIt([&] { vectorRoundTrip(li); }), n);
+  }
+  {
+    MyList<std::string> li = randomStrings(n);
+    report("MyList::sort (relink only)", timeIt([&] { li.sort(); }), n);
+    keep(li.front());
+  }
+  {
+    MyList<std::string> a = randomStrings(n / 2);
+    MyList<std::string> b = randomStrings(n - n / 2);
+    a.sort();
+    b.sort();
+    report("MyList::merge of two sorted halves", timeIt([&] { a.merge(b); }), n);
+  }
+  return 0;
+}
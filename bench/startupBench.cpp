@@ -0,0 +1,60 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include "benchUtil.hpp"
+#include "mappedList.hpp"
+#include "myList.hpp"
+
+// Restart cost: rebuilding a list from a text dump against reopening a
+// MappedList.  Both files come out of the page cache here, as they would
+// on a warm restart.
+int main(int argc, char* argv[]) {
+  const long long n = scaled(10'000'000, argc, argv);
+  auto dir = std::filesystem::temp_directory_path();
+  auto textPath = (dir / "startupBench.txt").string();
+  auto mappedPath = (dir / "startupBench.bin").string();
+  std::filesystem::remove(mappedPath);
+
+  std::mt19937_64 mt {24};
+  {
+    std::ofstream text(textPath);
+    for (long long i = 0; i < n; ++i) {
+      text << static_cast<long long>(mt() >> 20) << '\n';
+    }
+  }
+  report("MappedList append from text, flush", timeIt([&] {
+    std::ifstream text(textPath);
+    MappedList<long long> li(mappedPath);
+    li.reserve(static_cast<int>(n));
+    for (long long x; text >> x;) {
+      li.push_back(x);
+    }
+    li.flush();
+  }), n);
+
+  report("MyList rebuild from text", timeIt([&] {
+    std::ifstream text(textPath);
+    MyList<long long> li {};
+    for (long long x; text >> x;) {
+      li.push_back(x);
+    }
+    keep(li.size());
+  }), n);
+  report("MappedList reopen", timeIt([&] {
+    MappedList<long long> li(mappedPath);
+    keep(li.size());
+  }), n);
+  report("MappedList reopen and walk", timeIt([&] {
+    MappedList<long long> li(mappedPath);
+    long long sum = 0;
+    for (long long x : li) {
+      sum += x;
+    }
+    keep(sum);
+  }), n);
+
+  std::filesystem::remove(textPath);
+  std::filesystem::remove(mappedPath);
+  return 0;
+}
@@ -0,0 +1,75 @@
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "benchUtil.hpp"
+#include "listStream.hpp"
+#include "myList.hpp"
+
+// something read from each element, so consuming one has to load it
+std::size_t consume(int value) {
+  return static_cast<std::size_t>(value);
+}
+
+std::size_t consume(const std::string& value) {
+  return value.size();
+}
+
+// GB/s over the bytes of the serialised form, to and from memory streams
+template <typename T>
+void measure(const std::string& name, const MyList<T>& list) {
+  std::stringstream buffer {};
+  double writeTime = timeIt([&] { write(buffer, list); });
+  std::string bytes = buffer.str();
+  double gigabytes = static_cast<double>(bytes.size()) / 1e9;
+  std::cout << name << ": " << list.size() << " elements, " << bytes.size() << " bytes\n";
+  report("  write", writeTime, list.size());
+  std::cout << "    " << std::setprecision(2) << gigabytes / writeTime << " GB/s\n";
+
+  std::istringstream in(bytes);
+  MyList<T> loaded {};
+  double readTime = timeIt([&] {
+    ListReader<T> reader(in, loaded);
+    reader.read_all();
+  });
+  report("  read", readTime, list.size());
+  std::cout << "    " << std::setprecision(2) << gigabytes / readTime << " GB/s\n";
+
+  // load on one thread while this one walks what has arrived
+  std::istringstream again(bytes);
+  MyList<T> overlapped {};
+  double overlapTime = timeIt([&] {
+    ListReader<T> reader(again, overlapped);
+    std::thread loader([&] { reader.read_all(); });
+    int seen = 0;
+    std::size_t total = 0;
+    typename MyList<T>::Iterator it {};
+    for (int available = reader.wait_for(1); available > seen; available = reader.wait_for(seen + 1)) {
+      for (; seen < available; ++seen) {
+        it = seen == 0 ? overlapped.begin() : std::next(it);
+        total += consume(*it);
+      }
+    }
+    loader.join();
+    keep(total);
+  });
+  report("  read while consuming", overlapTime, list.size());
+}
+
+int main(int argc, char* argv[]) {
+  const long long n = scaled(50'000'000, argc, argv);
+  MyList<int> ints {};
+  for (long long i = 0; i < n; ++i) {
+    ints.push_back(static_cast<int>(i));
+  }
+  measure("MyList<int>", ints);
+  ints.clear();
+
+  MyList<std::string> words {};
+  for (long long i = 0; i < n / 5; ++i) {
+    words.push_back(std::string(static_cast<std::size_t>(8 + i % 33), 'w'));
+  }
+  measure("MyList<std::string>", words);
+  return 0;
+}
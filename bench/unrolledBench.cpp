@@ -0,0 +1,43 @@
+#include <iostream>
+#include <list>
+#include "benchUtil.hpp"
+#include "myList.hpp"
+#include "unrolledList.hpp"
+
+// build a list of n ints with push_back, then sum it with a range-for loop
+// enough times to touch roughly `work` elements
+template <typename List>
+void run(const std::string& name, long long n, long long work) {
+  List* li = new List {};
+  double build = timeIt([&] {
+    for (long long i = 0; i < n; ++i) {
+      li->push_back(static_cast<int>(i));
+    }
+  });
+  long long passes = work / n > 0 ? work / n : 1;
+  double walk = timeIt([&] {
+    for (long long p = 0; p < passes; ++p) {
+      long long sum = 0;
+      for (int x : *li) {
+        sum += x;
+      }
+      keep(sum);
+    }
+  });
+  report(name + " push_back", build, n);
+  report(name + " range-for", walk, n * passes);
+  delete li;
+}
+
+int main(int argc, char* argv[]) {
+  const long long maxN = scaled(100'000'000, argc, argv);
+  const long long work = scaled(100'000'000, argc, argv);
+  for (long long n = 1000; n <= maxN; n *= 10) {
+    std::cout << "n = " << n << "\n";
+    run<MyList<int>>("  MyList<int>", n, work);
+    run<std::list<int>>("  std::list<int>", n, work);
+    run<UnrolledList<int, 16>>("  UnrolledList<int, 16>", n, work);
+    run<UnrolledList<int, 64>>("  UnrolledList<int, 64>", n, work);
+  }
+  return 0;
+}
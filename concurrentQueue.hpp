@@ -0,0 +1,159 @@
+#ifndef CONCURRENT_QUEUE_HPP_
+#define CONCURRENT_QUEUE_HPP_
+
+#include <atomic>
+#include <new>
+#include <utility>
+#include "epochDomain.hpp"
+
+// Unbounded multi-producer multi-consumer FIFO queue (Michael & Scott).
+// The nodes form a singly linked chain from head_ to tail_ through atomic
+// next links; head_ always points at a dummy node whose value has already
+// been taken, so push_back and pop_front never touch the same link unless
+// the queue is empty.  Neither takes a lock: a thread that finds tail_
+// lagging behind swings it forward itself instead of waiting.
+//
+// A node is retired to the EpochDomain when it stops being the dummy and
+// freed once no thread can still be reading it, so a slow consumer never
+// follows a link into freed memory and no node is recycled while a CAS
+// could mistake it for its old self.
+template <typename T>
+class ConcurrentQueue {
+public:
+    // MyList's node without prev: a push only ever links at the tail
+    struct Node {
+        std::atomic<Node*> next{ nullptr };
+        // constructed by push_back, destroyed by the pop_front that takes it
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* value() {
+            return std::launder(reinterpret_cast<T*>(storage));
+        }
+    };
+
+private:
+    // apart on separate cache lines so producers and consumers do not
+    // invalidate each other's line on every operation
+    alignas(64) std::atomic<Node*> head_;
+    alignas(64) std::atomic<Node*> tail_;
+
+public:
+    ConcurrentQueue();
+    ConcurrentQueue(const ConcurrentQueue&) = delete;
+    ConcurrentQueue& operator=(const ConcurrentQueue&) = delete;
+    // no other thread may be using the queue any more
+    ~ConcurrentQueue();
+
+    void push_back(const T& value);
+    void push_back(T&& value);
+    template <typename... Args>
+    void emplace_back(Args&&... args);
+    // move the oldest value into out; false if the queue was empty
+    bool pop_front(T& out);
+
+    // a snapshot that may be stale by the time it is returned
+    bool empty() const;
+
+private:
+    void link(Node* node);
+};
+
+template <typename T>
+ConcurrentQueue<T>::ConcurrentQueue() {
+    Node* dummy = new Node;
+    head_.store(dummy, std::memory_order_relaxed);
+    tail_.store(dummy, std::memory_order_relaxed);
+}
+
+template <typename T>
+ConcurrentQueue<T>::~ConcurrentQueue() {
+    Node* node = head_.load(std::memory_order_relaxed);
+    Node* next = node->next.load(std::memory_order_relaxed);
+    delete node;
+    while (next != nullptr) {
+        node = next;
+        next = node->next.load(std::memory_order_relaxed);
+        node->value()->~T();
+        delete node;
+    }
+}
+
+template <typename T>
+void ConcurrentQueue<T>::push_back(const T& value) {
+    emplace_back(value);
+}
+
+template <typename T>
+void ConcurrentQueue<T>::push_back(T&& value) {
+    emplace_back(std::move(value));
+}
+
+template <typename T>
+template <typename... Args>
+void ConcurrentQueue<T>::emplace_back(Args&&... args) {
+    Node* node = new Node;
+    try {
+        ::new (static_cast<void*>(node->storage)) T(std::forward<Args>(args)...);
+    }
+    catch (...) {
+        delete node;
+        throw;
+    }
+    link(node);
+}
+
+template <typename T>
+bool ConcurrentQueue<T>::pop_front(T& out) {
+    EpochDomain::Guard guard;
+    for (;;) {
+        Node* head = head_.load(std::memory_order_acquire);
+        Node* tail = tail_.load(std::memory_order_acquire);
+        Node* next = head->next.load(std::memory_order_acquire);
+        if (head != head_.load(std::memory_order_acquire)) {
+            continue;
+        }
+        if (head == tail) {
+            if (next == nullptr) {
+                return false;
+            }
+            // a push has linked next but not yet moved tail_ onto it
+            tail_.compare_exchange_weak(tail, next, std::memory_order_release, std::memory_order_relaxed);
+        }
+        else if (head_.compare_exchange_weak(head, next, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            // only the winner of the CAS touches next's value; next is the
+            // dummy now and the old dummy goes to the domain
+            out = std::move(*next->value());
+            next->value()->~T();
+            EpochDomain::instance().retire(head);
+            return true;
+        }
+    }
+}
+
+template <typename T>
+bool ConcurrentQueue<T>::empty() const {
+    EpochDomain::Guard guard;
+    return head_.load(std::memory_order_acquire)->next.load(std::memory_order_acquire) == nullptr;
+}
+
+template <typename T>
+void ConcurrentQueue<T>::link(Node* node) {
+    EpochDomain::Guard guard;
+    for (;;) {
+        Node* tail = tail_.load(std::memory_order_acquire);
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (tail != tail_.load(std::memory_order_acquire)) {
+            continue;
+        }
+        if (next != nullptr) {
+            // help the push that linked next finish
+            tail_.compare_exchange_weak(tail, next, std::memory_order_release, std::memory_order_relaxed);
+        }
+        else if (tail->next.compare_exchange_weak(next, node, std::memory_order_release, std::memory_order_relaxed)) {
+            tail_.compare_exchange_strong(tail, node, std::memory_order_release, std::memory_order_relaxed);
+            return;
+        }
+    }
+}
+
+#endif // CONCURRENT_QUEUE_HPP_
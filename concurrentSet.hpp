@@ -0,0 +1,210 @@
+#ifndef CONCURRENT_SET_HPP_
+#define CONCURRENT_SET_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include "epochDomain.hpp"
+
+// Lock-free sorted set of unique values on a singly linked list (Harris,
+// with Michael's one-node-at-a-time unlinking).
+// Erasing is two steps: first the low bit of the victim's own next link is
+// set, which marks it logically deleted and makes every CAS on that link
+// fail, so nothing can be inserted behind a node on its way out; then the
+// node is unlinked from its predecessor.  Whichever thread's CAS unlinks a
+// marked node - the eraser or a later traversal helping it along - retires
+// it to the EpochDomain.
+//
+// contains() never writes to shared memory.  size() is exact once the
+// threads mutating the set have finished, and approximate while they run.
+template <typename T, typename Compare = std::less<T>>
+class ConcurrentSet {
+public:
+    // MyList's node without prev; next carries the deletion mark in bit 0
+    struct Node {
+        std::atomic<std::uintptr_t> next{ 0 };
+        T value;
+        template <typename... Args>
+        explicit Node(Args&&... args) : value(std::forward<Args>(args)...) {}
+    };
+
+private:
+    // acts as the next link of a head sentinel, and is never marked
+    std::atomic<std::uintptr_t> head_{ 0 };
+    std::atomic<int> size_{ 0 };
+    Compare less_;
+
+    // where value belongs: cur is the first node not less than value, prev
+    // the link pointing at it
+    struct Window {
+        std::atomic<std::uintptr_t>* prev;
+        Node* cur;
+        bool found;
+    };
+
+public:
+    ConcurrentSet() = default;
+    explicit ConcurrentSet(Compare comp) : less_(std::move(comp)) {}
+    ConcurrentSet(const ConcurrentSet&) = delete;
+    ConcurrentSet& operator=(const ConcurrentSet&) = delete;
+    // no other thread may be using the set any more
+    ~ConcurrentSet();
+
+    // false if an equal value was already present
+    bool insert(const T& value);
+    // false if no equal value was present
+    bool erase(const T& value);
+    bool contains(const T& value) const;
+
+    bool empty() const;
+    int size() const;
+
+    // visit the values in order; only safe while no thread is mutating
+    template <typename F>
+    void for_each(F f) const;
+
+private:
+    static Node* pointer(std::uintptr_t link);
+    static bool marked(std::uintptr_t link);
+    Window find(const T& value);
+};
+
+template <typename T, typename Compare>
+ConcurrentSet<T, Compare>::~ConcurrentSet() {
+    Node* node = pointer(head_.load(std::memory_order_relaxed));
+    while (node != nullptr) {
+        Node* next = pointer(node->next.load(std::memory_order_relaxed));
+        delete node;
+        node = next;
+    }
+}
+
+template <typename T, typename Compare>
+bool ConcurrentSet<T, Compare>::insert(const T& value) {
+    EpochDomain::Guard guard;
+    Node* node = nullptr;
+    for (;;) {
+        Window w = find(value);
+        if (w.found) {
+            delete node;
+            return false;
+        }
+        if (node == nullptr) {
+            node = new Node(value);
+        }
+        auto expected = reinterpret_cast<std::uintptr_t>(w.cur);
+        node->next.store(expected, std::memory_order_relaxed);
+        if (w.prev->compare_exchange_strong(expected, reinterpret_cast<std::uintptr_t>(node),
+                                            std::memory_order_release, std::memory_order_relaxed)) {
+            size_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+}
+
+template <typename T, typename Compare>
+bool ConcurrentSet<T, Compare>::erase(const T& value) {
+    EpochDomain::Guard guard;
+    for (;;) {
+        Window w = find(value);
+        if (!w.found) {
+            return false;
+        }
+        std::uintptr_t next = w.cur->next.load(std::memory_order_acquire);
+        if (marked(next)) {
+            // another erase got there first; find unlinks it on the retry
+            continue;
+        }
+        if (!w.cur->next.compare_exchange_strong(next, next | 1, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            continue;
+        }
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        auto expected = reinterpret_cast<std::uintptr_t>(w.cur);
+        if (w.prev->compare_exchange_strong(expected, next, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            EpochDomain::instance().retire(w.cur);
+        }
+        else {
+            // the predecessor changed under us; a traversal unlinks it
+            find(value);
+        }
+        return true;
+    }
+}
+
+template <typename T, typename Compare>
+bool ConcurrentSet<T, Compare>::contains(const T& value) const {
+    EpochDomain::Guard guard;
+    Node* cur = pointer(head_.load(std::memory_order_acquire));
+    while (cur != nullptr && less_(cur->value, value)) {
+        cur = pointer(cur->next.load(std::memory_order_acquire));
+    }
+    return cur != nullptr && !less_(value, cur->value) && !marked(cur->next.load(std::memory_order_acquire));
+}
+
+template <typename T, typename Compare>
+bool ConcurrentSet<T, Compare>::empty() const {
+    return size() == 0;
+}
+
+template <typename T, typename Compare>
+int ConcurrentSet<T, Compare>::size() const {
+    return size_.load(std::memory_order_relaxed);
+}
+
+template <typename T, typename Compare>
+template <typename F>
+void ConcurrentSet<T, Compare>::for_each(F f) const {
+    for (Node* cur = pointer(head_.load(std::memory_order_acquire)); cur != nullptr;) {
+        std::uintptr_t next = cur->next.load(std::memory_order_acquire);
+        if (!marked(next)) {
+            f(static_cast<const T&>(cur->value));
+        }
+        cur = pointer(next);
+    }
+}
+
+template <typename T, typename Compare>
+typename ConcurrentSet<T, Compare>::Node* ConcurrentSet<T, Compare>::pointer(std::uintptr_t link) {
+    return reinterpret_cast<Node*>(link & ~std::uintptr_t{ 1 });
+}
+
+template <typename T, typename Compare>
+bool ConcurrentSet<T, Compare>::marked(std::uintptr_t link) {
+    return (link & 1) != 0;
+}
+
+// walk from the head, unlinking every marked node met on the way; start
+// over whenever an unlink CAS fails, since prev may itself be going away
+template <typename T, typename Compare>
+typename ConcurrentSet<T, Compare>::Window ConcurrentSet<T, Compare>::find(const T& value) {
+    for (;;) {
+        std::atomic<std::uintptr_t>* prev = &head_;
+        Node* cur = pointer(prev->load(std::memory_order_acquire));
+        bool restart = false;
+        while (cur != nullptr) {
+            std::uintptr_t next = cur->next.load(std::memory_order_acquire);
+            if (marked(next)) {
+                auto expected = reinterpret_cast<std::uintptr_t>(cur);
+                if (!prev->compare_exchange_strong(expected, next & ~std::uintptr_t{ 1 },
+                                                   std::memory_order_acq_rel, std::memory_order_acquire)) {
+                    restart = true;
+                    break;
+                }
+                EpochDomain::instance().retire(cur);
+                cur = pointer(next);
+                continue;
+            }
+            if (!less_(cur->value, value)) {
+                return Window{ prev, cur, !less_(value, cur->value) };
+            }
+            prev = &cur->next;
+            cur = pointer(next);
+        }
+        if (!restart) {
+            return Window{ prev, nullptr, false };
+        }
+    }
+}
+
+#endif // CONCURRENT_SET_HPP_
@@ -0,0 +1,201 @@
+#ifndef EPOCH_DOMAIN_HPP_
+#define EPOCH_DOMAIN_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Epoch-based reclamation for the lock-free containers.
+// A thread pins the domain (holds a Guard) for as long as it may touch
+// shared nodes.  A node that has been unlinked is retired rather than
+// freed: it is stamped with the global epoch and parked on the retiring
+// thread's record.  The global epoch only moves on once every pinned
+// thread has seen the current one, so by the time it has moved on twice
+// no thread can still hold a pointer to the node, and it is freed.
+//
+// There is one process-wide domain.  Each thread gets a record on first
+// use and hands it back when it exits; retired nodes stay on the record
+// until it is reused or the domain is destroyed, so none are leaked.
+class EpochDomain {
+public:
+    // frees storage that is no longer reachable by any thread
+    using Reclaim = void (*)(void*);
+
+private:
+    struct Record;
+
+public:
+    class Guard {
+    public:
+        Guard() : record_{ EpochDomain::instance().pin() } {}
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        ~Guard() {
+            EpochDomain::instance().unpin(*record_);
+        }
+
+    private:
+        Record* record_;
+    };
+
+private:
+    struct Retired {
+        void* pointer;
+        Reclaim reclaim;
+        std::uint64_t epoch;
+    };
+
+    struct Record {
+        // (epoch << 1) | 1 while pinned, 0 while quiescent
+        std::atomic<std::uint64_t> state{ 0 };
+        std::atomic<bool> taken{ true };
+        Record* next{ nullptr };
+        int nesting{ 0 };
+        // oldest first, since the epoch never goes back
+        std::vector<Retired> retired;
+        // retired.size() at which to try collecting again
+        std::size_t collectAt{ collectInterval };
+    };
+
+    // how many nodes a thread retires between attempts to advance the epoch
+    static constexpr std::size_t collectInterval = 64;
+
+    // hand a record back when its thread exits
+    struct Owner {
+        Record* record{ nullptr };
+        ~Owner() {
+            if (record != nullptr) {
+                EpochDomain::instance().collect(*record);
+                record->taken.store(false, std::memory_order_release);
+            }
+        }
+    };
+
+
+    std::atomic<std::uint64_t> epoch_{ 1 };
+    std::atomic<Record*> records_{ nullptr };
+
+public:
+    EpochDomain() = default;
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+    // runs after every other thread has gone, so everything can be freed
+    ~EpochDomain() {
+        Record* record = records_.load();
+        while (record != nullptr) {
+            for (const auto& r : record->retired) {
+                r.reclaim(r.pointer);
+            }
+            Record* next = record->next;
+            delete record;
+            record = next;
+        }
+    }
+
+    static EpochDomain& instance() {
+        static EpochDomain domain;
+        return domain;
+    }
+
+    // hand pointer over for reclamation once no pinned thread can see it.
+    // The caller must hold a Guard and must already have unlinked pointer.
+    void retire(void* pointer, Reclaim reclaim) {
+        Record& record = local();
+        record.retired.push_back(Retired{ pointer, reclaim, epoch_.load(std::memory_order_acquire) });
+        if (record.retired.size() >= record.collectAt) {
+            collect(record);
+        }
+    }
+
+    template <typename Node>
+    void retire(Node* node) {
+        retire(node, [](void* p) { delete static_cast<Node*>(p); });
+    }
+
+    // try to move the epoch on and free what this thread retired long enough ago
+    void collect() {
+        collect(local());
+    }
+
+private:
+    Record& local() {
+        thread_local Owner owner;
+        if (owner.record == nullptr) {
+            owner.record = acquire();
+        }
+        return *owner.record;
+    }
+
+    // reuse a record left by an exited thread, or publish a new one
+    Record* acquire() {
+        for (Record* record = records_.load(std::memory_order_acquire); record != nullptr; record = record->next) {
+            bool expected = false;
+            if (!record->taken.load(std::memory_order_relaxed)
+                && record->taken.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                return record;
+            }
+        }
+        Record* record = new Record;
+        Record* head = records_.load(std::memory_order_relaxed);
+        do {
+            record->next = head;
+        } while (!records_.compare_exchange_weak(head, record, std::memory_order_release, std::memory_order_relaxed));
+        return record;
+    }
+
+    Record* pin() {
+        Record& record = local();
+        if (record.nesting++ == 0) {
+            // announce the epoch, then make sure it did not move on before
+            // the announcement became visible.  Only the thread's own record
+            // is written, so pinning costs no read-modify-write.
+            std::uint64_t epoch = epoch_.load(std::memory_order_relaxed);
+            for (;;) {
+                record.state.store(epoch << 1 | 1, std::memory_order_seq_cst);
+                std::uint64_t now = epoch_.load(std::memory_order_seq_cst);
+                if (now == epoch) {
+                    break;
+                }
+                epoch = now;
+            }
+        }
+        return &record;
+    }
+
+    void unpin(Record& record) {
+        if (--record.nesting == 0) {
+            record.state.store(0, std::memory_order_release);
+        }
+    }
+
+    // the epoch moves on only when every pinned thread is in it
+    void tryAdvance() {
+        std::uint64_t epoch = epoch_.load(std::memory_order_seq_cst);
+        for (Record* record = records_.load(std::memory_order_acquire); record != nullptr; record = record->next) {
+            std::uint64_t state = record->state.load(std::memory_order_seq_cst);
+            if ((state & 1) != 0 && (state >> 1) != epoch) {
+                return;
+            }
+        }
+        epoch_.compare_exchange_strong(epoch, epoch + 1, std::memory_order_acq_rel, std::memory_order_relaxed);
+    }
+
+    // free the expired prefix of record's retired nodes.  While a stalled
+    // thread holds the epoch back the list only grows, so the next attempt
+    // waits until it has doubled rather than rescanning it every interval.
+    void collect(Record& record) {
+        tryAdvance();
+        std::uint64_t epoch = epoch_.load(std::memory_order_acquire);
+        std::size_t expired = 0;
+        while (expired < record.retired.size() && record.retired[expired].epoch + 2 <= epoch) {
+            const Retired& r = record.retired[expired++];
+            r.reclaim(r.pointer);
+        }
+        record.retired.erase(record.retired.begin(), record.retired.begin() + expired);
+        record.collectAt = record.retired.size() + std::max(record.retired.size(), collectInterval);
+    }
+};
+
+#endif // EPOCH_DOMAIN_HPP_
@@ -0,0 +1,506 @@
+#ifndef INDEXED_LIST_HPP_
+#define INDEXED_LIST_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Doubly linked list whose nodes live in one contiguous vector and link to
+// each other by 32-bit slot index instead of by pointer.  For small T this
+// cuts a node to two indices plus the payload (12 bytes for int, against
+// two pointers plus allocator overhead per MyList node), and since no link
+// is an address, the slot vector can be relocated, memcpy'd or written out
+// as-is when T is trivially copyable.
+//
+// Slot 0 is the sentinel: its next is the first element and its prev the
+// last.  Erased slots are chained through next into a free list and reused
+// before the vector grows.  Iterators hold an index, so they survive the
+// vector growing.
+//
+// A slot holds its element in raw storage, built when the slot is linked
+// and destroyed when it is unlinked, so the sentinel and free slots hold
+// no T.  The vector only ever copies slots as bytes; for T that is not
+// trivially copyable the list grows and copies it element by element.
+template <typename T>
+class IndexedList {
+public:
+    using Index = std::uint32_t;
+
+    struct Slot {
+        Index prev{ 0 };
+        Index next{ 0 };
+        // live unless this is slot 0 or prev is freeMark
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* value() {
+            return std::launder(reinterpret_cast<T*>(storage));
+        }
+
+        const T* value() const {
+            return std::launder(reinterpret_cast<const T*>(storage));
+        }
+    };
+
+    template <bool Const>
+    class BasicIterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+        using ListPtr = std::conditional_t<Const, const IndexedList*, IndexedList*>;
+
+        ListPtr list_{ nullptr };
+        Index current_{ 0 };
+
+        BasicIterator() = default;
+        BasicIterator(ListPtr list, Index index) : list_(list), current_(index) {}
+        // Iterator converts to ConstIterator, not the other way round
+        template <bool WasConst, typename = std::enable_if_t<Const && !WasConst>>
+        BasicIterator(const BasicIterator<WasConst>& other) : list_(other.list_), current_(other.current_) {}
+
+        BasicIterator& operator++() {
+            current_ = list_->slots_[current_].next;
+            return *this;
+        }
+
+        BasicIterator operator++(int) {
+            BasicIterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        BasicIterator& operator--() {
+            current_ = list_->slots_[current_].prev;
+            return *this;
+        }
+
+        BasicIterator operator--(int) {
+            BasicIterator old = *this;
+            --*this;
+            return old;
+        }
+
+        reference operator*() const {
+            return *list_->slots_[current_].value();
+        }
+
+        pointer operator->() const {
+            return &**this;
+        }
+
+        friend bool operator==(const BasicIterator& a, const BasicIterator& b) {
+            return a.current_ == b.current_ && a.list_ == b.list_;
+        }
+
+        friend bool operator!=(const BasicIterator& a, const BasicIterator& b) {
+            return !(a == b);
+        }
+    };
+
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
+private:
+    static constexpr bool trivial = std::is_trivially_copyable_v<T>;
+    // the prev of a free slot; link() never hands out this index
+    static constexpr Index freeMark = UINT32_MAX;
+
+    std::vector<Slot> slots_;
+    // first free slot, 0 when there is none
+    Index freeHead_;
+    int size_;
+
+public:
+    IndexedList();
+    IndexedList(std::initializer_list<T> vals);
+    IndexedList(const IndexedList& other);
+    IndexedList(IndexedList&& other);
+    IndexedList& operator=(const IndexedList& other);
+    IndexedList& operator=(IndexedList&& other) noexcept;
+    ~IndexedList();
+
+    T& front();
+    const T& front() const;
+    T& back();
+    const T& back() const;
+
+    void push_front(const T& value);
+    void push_front(T&& value);
+    template <typename... Args>
+    T& emplace_front(Args&&... args);
+    void pop_front();
+    void push_back(const T& value);
+    void push_back(T&& value);
+    template <typename... Args>
+    T& emplace_back(Args&&... args);
+    void pop_back();
+
+    void insert(const Iterator& position, const T& value);
+    void insert(const Iterator& position, T&& value);
+    template <typename... Args>
+    Iterator emplace(const Iterator& position, Args&&... args);
+    void erase(const Iterator& position);
+
+    bool empty() const;
+    int size() const;
+
+    void clear();
+    void swap(IndexedList& other) noexcept;
+    // make room for n elements without reallocating
+    void reserve(int n);
+
+    // bytes held by the slot vector, live and free slots included
+    std::size_t memoryBytes() const;
+    // the raw slots, sentinel first; every link in them is an index
+    const std::vector<Slot>& slots() const;
+
+    Iterator begin();
+    Iterator end();
+    ConstIterator begin() const;
+    ConstIterator end() const;
+
+private:
+    void initialize();
+    template <typename... Args>
+    Index link(Index position, Args&&... args);
+    void unlink(Index index);
+    void destroyAll();
+    void reallocate(std::size_t capacity);
+    void relocate(std::size_t capacity);
+};
+
+template <typename T>
+IndexedList<T>::IndexedList() {
+    initialize();
+}
+
+template <typename T>
+IndexedList<T>::IndexedList(std::initializer_list<T> vals) {
+    initialize();
+    reserve(static_cast<int>(vals.size()));
+    for (const auto& val : vals) {
+        push_back(val);
+    }
+}
+
+// the slots are copied as they are, free ones included, so indices match
+template <typename T>
+IndexedList<T>::IndexedList(const IndexedList& other)
+    : slots_(other.slots_), freeHead_{ other.freeHead_ }, size_{ other.size_ } {
+    if constexpr (!trivial) {
+        Index built = 0;
+        try {
+            for (Index i = slots_[0].next; i != 0; i = slots_[i].next, ++built) {
+                ::new (static_cast<void*>(slots_[i].storage)) T(*other.slots_[i].value());
+            }
+        }
+        catch (...) {
+            for (Index i = slots_[0].next; built > 0; i = slots_[i].next, --built) {
+                std::destroy_at(slots_[i].value());
+            }
+            throw;
+        }
+    }
+}
+
+// other is left empty, which takes a new sentinel slot
+template <typename T>
+IndexedList<T>::IndexedList(IndexedList&& other)
+    : slots_(std::move(other.slots_)), freeHead_{ other.freeHead_ }, size_{ other.size_ } {
+    other.slots_.clear();
+    other.initialize();
+}
+
+template <typename T>
+IndexedList<T>& IndexedList<T>::operator=(const IndexedList& other) {
+    if (this != &other) {
+        IndexedList copy(other);
+        swap(copy);
+    }
+    return *this;
+}
+
+// the old contents go to other and are released with it
+template <typename T>
+IndexedList<T>& IndexedList<T>::operator=(IndexedList&& other) noexcept {
+    swap(other);
+    return *this;
+}
+
+template <typename T>
+IndexedList<T>::~IndexedList() {
+    destroyAll();
+}
+
+template <typename T>
+T& IndexedList<T>::front() {
+    return *slots_[slots_[0].next].value();
+}
+
+template <typename T>
+const T& IndexedList<T>::front() const {
+    return *slots_[slots_[0].next].value();
+}
+
+template <typename T>
+T& IndexedList<T>::back() {
+    return *slots_[slots_[0].prev].value();
+}
+
+template <typename T>
+const T& IndexedList<T>::back() const {
+    return *slots_[slots_[0].prev].value();
+}
+
+template <typename T>
+void IndexedList<T>::push_front(const T& value) {
+    emplace_front(value);
+}
+
+template <typename T>
+void IndexedList<T>::push_front(T&& value) {
+    emplace_front(std::move(value));
+}
+
+template <typename T>
+template <typename... Args>
+T& IndexedList<T>::emplace_front(Args&&... args) {
+    return *slots_[link(slots_[0].next, std::forward<Args>(args)...)].value();
+}
+
+template <typename T>
+void IndexedList<T>::pop_front() {
+    if (size_ > 0) {
+        unlink(slots_[0].next);
+    }
+}
+
+template <typename T>
+void IndexedList<T>::push_back(const T& value) {
+    emplace_back(value);
+}
+
+template <typename T>
+void IndexedList<T>::push_back(T&& value) {
+    emplace_back(std::move(value));
+}
+
+template <typename T>
+template <typename... Args>
+T& IndexedList<T>::emplace_back(Args&&... args) {
+    return *slots_[link(0, std::forward<Args>(args)...)].value();
+}
+
+template <typename T>
+void IndexedList<T>::pop_back() {
+    if (size_ > 0) {
+        unlink(slots_[0].prev);
+    }
+}
+
+template <typename T>
+void IndexedList<T>::insert(const Iterator& position, const T& value) {
+    emplace(position, value);
+}
+
+template <typename T>
+void IndexedList<T>::insert(const Iterator& position, T&& value) {
+    emplace(position, std::move(value));
+}
+
+template <typename T>
+template <typename... Args>
+typename IndexedList<T>::Iterator IndexedList<T>::emplace(const Iterator& position, Args&&... args) {
+    return Iterator(this, link(position.current_, std::forward<Args>(args)...));
+}
+
+template <typename T>
+void IndexedList<T>::erase(const Iterator& position) {
+    unlink(position.current_);
+}
+
+template <typename T>
+bool IndexedList<T>::empty() const {
+    return size_ == 0;
+}
+
+template <typename T>
+int IndexedList<T>::size() const {
+    return size_;
+}
+
+template <typename T>
+void IndexedList<T>::clear() {
+    destroyAll();
+    slots_.clear();
+    initialize();
+}
+
+template <typename T>
+void IndexedList<T>::swap(IndexedList& other) noexcept {
+    slots_.swap(other.slots_);
+    std::swap(freeHead_, other.freeHead_);
+    std::swap(size_, other.size_);
+}
+
+template <typename T>
+void IndexedList<T>::reserve(int n) {
+    reallocate(static_cast<std::size_t>(n) + 1);
+}
+
+template <typename T>
+std::size_t IndexedList<T>::memoryBytes() const {
+    return slots_.capacity() * sizeof(Slot);
+}
+
+template <typename T>
+const std::vector<typename IndexedList<T>::Slot>& IndexedList<T>::slots() const {
+    return slots_;
+}
+
+template <typename T>
+typename IndexedList<T>::Iterator IndexedList<T>::begin() {
+    return Iterator(this, slots_[0].next);
+}
+
+template <typename T>
+typename IndexedList<T>::Iterator IndexedList<T>::end() {
+    return Iterator(this, 0);
+}
+
+template <typename T>
+typename IndexedList<T>::ConstIterator IndexedList<T>::begin() const {
+    return ConstIterator(this, slots_[0].next);
+}
+
+template <typename T>
+typename IndexedList<T>::ConstIterator IndexedList<T>::end() const {
+    return ConstIterator(this, 0);
+}
+
+template <typename T>
+void IndexedList<T>::initialize() {
+    if (slots_.empty()) {
+        slots_.emplace_back();
+    }
+    slots_[0].prev = 0;
+    slots_[0].next = 0;
+    freeHead_ = 0;
+    size_ = 0;
+}
+
+// Put a new element built from args in front of slot position and return
+// its index.  The element is built before the vector may grow, since args
+// may refer into the list.
+template <typename T>
+template <typename... Args>
+typename IndexedList<T>::Index IndexedList<T>::link(Index position, Args&&... args) {
+    Index index;
+    if (freeHead_ != 0) {
+        index = freeHead_;
+        Slot& slot = slots_[index];
+        ::new (static_cast<void*>(slot.storage)) T(std::forward<Args>(args)...);
+        freeHead_ = slot.next;
+    }
+    else {
+        if (slots_.size() > UINT32_MAX - 1) {
+            throw std::length_error("IndexedList is out of 32-bit slot indices");
+        }
+        if (slots_.size() == slots_.capacity()) {
+            T value(std::forward<Args>(args)...);
+            reallocate(slots_.size() * 2);
+            return link(position, std::move(value));
+        }
+        index = static_cast<Index>(slots_.size());
+        slots_.emplace_back();
+        try {
+            ::new (static_cast<void*>(slots_.back().storage)) T(std::forward<Args>(args)...);
+        }
+        catch (...) {
+            slots_.pop_back();
+            throw;
+        }
+    }
+    Index before = slots_[position].prev;
+    slots_[index].prev = before;
+    slots_[index].next = position;
+    slots_[before].next = index;
+    slots_[position].prev = index;
+    size_++;
+    return index;
+}
+
+template <typename T>
+void IndexedList<T>::unlink(Index index) {
+    Slot& slot = slots_[index];
+    slots_[slot.prev].next = slot.next;
+    slots_[slot.next].prev = slot.prev;
+    std::destroy_at(slot.value());
+    slot.prev = freeMark;
+    slot.next = freeHead_;
+    freeHead_ = index;
+    size_--;
+}
+
+// destroy the elements, leaving the links as they are
+template <typename T>
+void IndexedList<T>::destroyAll() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        for (Index i = slots_.empty() ? 0 : slots_[0].next; i != 0; i = slots_[i].next) {
+            std::destroy_at(slots_[i].value());
+        }
+    }
+}
+
+// Grow the vector to at least capacity slots.  Unless T is trivially
+// copyable, each live element is moved (or copied, if its move may throw)
+// into its new slot, and a throwing copy leaves the list as it was.
+template <typename T>
+void IndexedList<T>::reallocate(std::size_t capacity) {
+    if (capacity <= slots_.capacity()) {
+        return;
+    }
+    if constexpr (trivial) {
+        slots_.reserve(capacity);
+    }
+    else {
+        relocate(capacity);
+    }
+}
+
+template <typename T>
+void IndexedList<T>::relocate(std::size_t capacity) {
+    std::vector<Slot> moved;
+    moved.reserve(capacity);
+    moved.insert(moved.end(), slots_.begin(), slots_.end());
+    auto live = [&](Index i) { return i != 0 && slots_[i].prev != freeMark; };
+    Index i = 0;
+    try {
+        for (; i < slots_.size(); ++i) {
+            if (live(i)) {
+                ::new (static_cast<void*>(moved[i].storage)) T(std::move_if_noexcept(*slots_[i].value()));
+            }
+        }
+    }
+    catch (...) {
+        while (i-- > 0) {
+            if (live(i)) {
+                std::destroy_at(moved[i].value());
+            }
+        }
+        throw;
+    }
+    destroyAll();
+    slots_.swap(moved);
+}
+
+#endif // INDEXED_LIST_HPP_
@@ -0,0 +1,304 @@
+#ifndef INTRUSIVE_LIST_HPP_
+#define INTRUSIVE_LIST_HPP_
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+// Links embedded in an element so that it can sit on a MyIntrusiveList.
+// An element that should be on several lists at once carries one hook per
+// list.  Copying an element gives the copy fresh, unlinked hooks.
+class ListHook {
+public:
+    ListHook* prev{ nullptr };
+    ListHook* next{ nullptr };
+    // the element this hook is embedded in; null for a list's sentinel
+    void* owner{ nullptr };
+
+    ListHook() = default;
+    ListHook(const ListHook&) {}
+    ListHook& operator=(const ListHook&) {
+        return *this;
+    }
+
+    bool isLinked() const {
+        return next != nullptr;
+    }
+};
+
+// Doubly linked list over elements that it does not own.  The prev/next
+// links live in a ListHook member of T, named by the Hook template
+// argument, so linking and unlinking never allocate or copy, and an element
+// can be unlinked in O(1) given only a reference to it.  The list is
+// circular around an embedded sentinel and iterates like MyList.
+//
+// Elements must outlive their membership: erase an element (or clear the
+// list) before destroying it.
+template <typename T, ListHook T::*Hook>
+class MyIntrusiveList {
+public:
+    template <bool Const>
+    class BasicIterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+        using HookPtr = std::conditional_t<Const, const ListHook*, ListHook*>;
+
+        HookPtr current_{ nullptr };
+
+        BasicIterator() = default;
+        BasicIterator(HookPtr hook) : current_(hook) {}
+        // Iterator converts to ConstIterator, not the other way round
+        template <bool WasConst, typename = std::enable_if_t<Const && !WasConst>>
+        BasicIterator(const BasicIterator<WasConst>& other) : current_(other.current_) {}
+
+        BasicIterator& operator++() {
+            current_ = current_->next;
+            return *this;
+        }
+
+        BasicIterator operator++(int) {
+            BasicIterator old = *this;
+            current_ = current_->next;
+            return old;
+        }
+
+        BasicIterator& operator--() {
+            current_ = current_->prev;
+            return *this;
+        }
+
+        BasicIterator operator--(int) {
+            BasicIterator old = *this;
+            current_ = current_->prev;
+            return old;
+        }
+
+        reference operator*() const {
+            return *static_cast<pointer>(current_->owner);
+        }
+
+        pointer operator->() const {
+            return static_cast<pointer>(current_->owner);
+        }
+
+        friend bool operator==(const BasicIterator& a, const BasicIterator& b) {
+            return a.current_ == b.current_;
+        }
+
+        friend bool operator!=(const BasicIterator& a, const BasicIterator& b) {
+            return !(a == b);
+        }
+    };
+
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
+private:
+    ListHook endnode;
+
+    int size_;
+
+public:
+    MyIntrusiveList();
+    MyIntrusiveList(const MyIntrusiveList&) = delete;
+    MyIntrusiveList& operator=(const MyIntrusiveList&) = delete;
+    MyIntrusiveList(MyIntrusiveList&& other) noexcept;
+    ~MyIntrusiveList();
+
+    T& front();
+    const T& front() const;
+    T& back();
+    const T& back() const;
+
+    void push_front(T& value);
+    void pop_front();
+    void push_back(T& value);
+    void pop_back();
+
+    Iterator insert(const Iterator& position, T& value);
+    void erase(const Iterator& position);
+    // unlink value, which must be on this list
+    void erase(T& value);
+
+    // iterator to an element known to be on this list
+    Iterator iteratorTo(T& value);
+
+    bool empty() const;
+    int size() const;
+
+    // unlink every element; the elements themselves are untouched
+    void clear();
+
+    Iterator begin();
+    Iterator end();
+    ConstIterator begin() const;
+    ConstIterator end() const;
+
+private:
+    void initialize();
+    void link(ListHook* position, T& value);
+    void unlink(ListHook* hook);
+};
+
+template <typename T, ListHook T::*Hook>
+MyIntrusiveList<T, Hook>::MyIntrusiveList() {
+    initialize();
+}
+
+template <typename T, ListHook T::*Hook>
+MyIntrusiveList<T, Hook>::MyIntrusiveList(MyIntrusiveList&& other) noexcept {
+    initialize();
+    if (other.size_ > 0) {
+        endnode.next = other.endnode.next;
+        endnode.prev = other.endnode.prev;
+        endnode.next->prev = &endnode;
+        endnode.prev->next = &endnode;
+        size_ = other.size_;
+        other.initialize();
+    }
+}
+
+template <typename T, ListHook T::*Hook>
+MyIntrusiveList<T, Hook>::~MyIntrusiveList() {
+    clear();
+}
+
+template <typename T, ListHook T::*Hook>
+T& MyIntrusiveList<T, Hook>::front() {
+    return *begin();
+}
+
+template <typename T, ListHook T::*Hook>
+const T& MyIntrusiveList<T, Hook>::front() const {
+    return *begin();
+}
+
+template <typename T, ListHook T::*Hook>
+T& MyIntrusiveList<T, Hook>::back() {
+    return *--end();
+}
+
+template <typename T, ListHook T::*Hook>
+const T& MyIntrusiveList<T, Hook>::back() const {
+    return *--end();
+}
+
+template <typename T, ListHook T::*Hook>
+void MyIntrusiveList<T, Hook>::push_front(T& value) {
+    link(endnode.next, value);
+}
+
+template <typename T, ListHook T::*Hook>
+void MyIntrusiveList<T, Hook>::pop_front() {
+    if (size_ > 0) {
+        unlink(endnode.next);
+    }
+}
+
+template <typename T, ListHook T::*Hook>
+void MyIntrusiveList<T, Hook>::push_back(T& value) {
+    link(&endnode, value);
+}
+
+template <typename T, ListHook T::*Hook>
+void MyIntrusiveList<T, Hook>::pop_back() {
+    if (size_ > 0) {
+        unlink(endnode.prev);
+    }
+}
+
+template <typename T, ListHook T::*Hook>
+typename MyIntrusiveList<T, Hook>::Iterator MyIntrusiveList<T, Hook>::insert(const Iterator& position, T& value) {
+    link(position.current_, value);
+    return Iterator(&(value.*Hook));
+}
+
+template <typename T, ListHook T::*Hook>
+void MyIntrusiveList<T, Hook>::erase(const Iterator& position) {
+    unlink(position.current_);
+}
+
+template <typename T, ListHook T::*Hook>
+void MyIntrusiveList<T, Hook>::erase(T& value) {
+    unlink(&(value.*Hook));
+}
+
+template <typename T, ListHook T::*Hook>
+typename MyIntrusiveList<T, Hook>::Iterator MyIntrusiveList<T, Hook>::iteratorTo(T& value) {
+    return Iterator(&(value.*Hook));
+}
+
+template <typename T, ListHook T::*Hook>
+bool MyIntrusiveList<T, Hook>::empty() const {
+    return size_ == 0;
+}
+
+template <typename T, ListHook T::*Hook>
+int MyIntrusiveList<T, Hook>::size() const {
+    return size_;
+}
+
+template <typename T, ListHook T::*Hook>
+void MyIntrusiveList<T, Hook>::clear() {
+    for (ListHook* current = endnode.next; current != &endnode;) {
+        ListHook* next = current->next;
+        current->prev = nullptr;
+        current->next = nullptr;
+        current = next;
+    }
+    initialize();
+}
+
+template <typename T, ListHook T::*Hook>
+typename MyIntrusiveList<T, Hook>::Iterator MyIntrusiveList<T, Hook>::begin() {
+    return Iterator(endnode.next);
+}
+
+template <typename T, ListHook T::*Hook>
+typename MyIntrusiveList<T, Hook>::Iterator MyIntrusiveList<T, Hook>::end() {
+    return Iterator(&endnode);
+}
+
+template <typename T, ListHook T::*Hook>
+typename MyIntrusiveList<T, Hook>::ConstIterator MyIntrusiveList<T, Hook>::begin() const {
+    return ConstIterator(endnode.next);
+}
+
+template <typename T, ListHook T::*Hook>
+typename MyIntrusiveList<T, Hook>::ConstIterator MyIntrusiveList<T, Hook>::end() const {
+    return ConstIterator(&endnode);
+}
+
+template <typename T, ListHook T::*Hook>
+void MyIntrusiveList<T, Hook>::initialize() {
+    endnode.prev = &endnode;
+    endnode.next = &endnode;
+    size_ = 0;
+}
+
+// link the hook of value in before position
+template <typename T, ListHook T::*Hook>
+void MyIntrusiveList<T, Hook>::link(ListHook* position, T& value) {
+    ListHook* hook = &(value.*Hook);
+    hook->owner = &value;
+    hook->prev = position->prev;
+    hook->next = position;
+    position->prev->next = hook;
+    position->prev = hook;
+    size_++;
+}
+
+template <typename T, ListHook T::*Hook>
+void MyIntrusiveList<T, Hook>::unlink(ListHook* hook) {
+    hook->prev->next = hook->next;
+    hook->next->prev = hook->prev;
+    hook->prev = nullptr;
+    hook->next = nullptr;
+    size_--;
+}
+
+#endif // INTRUSIVE_LIST_HPP_
@@ -0,0 +1,290 @@
+#ifndef LIST_STREAM_HPP_
+#define LIST_STREAM_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "myList.hpp"
+
+// Binary form of a MyList for sending it to another process or to disk.
+// The stream is a header followed by chunks of at most about chunkBytes
+// each, every chunk prefixed with its element count and byte length, and
+// ends with an empty chunk.  Numbers are in the writer's byte order, so
+// the reader must run on a machine of the same kind.
+//
+// Trivially copyable elements are stored as their raw bytes and copied in
+// and out of a chunk with memcpy.  Other element types need a ListCodec
+// specialisation:
+//
+//     template <>
+//     struct ListCodec<Foo> {
+//         // append the encoding of value to out
+//         static void encode(std::vector<char>& out, const Foo& value);
+//         // decode one element from [in, end) and move in past it; throw
+//         // std::runtime_error if the bytes run out
+//         static Foo decode(const char*& in, const char* end);
+//     };
+template <typename T>
+struct ListCodec;
+
+// length-prefixed bytes
+template <>
+struct ListCodec<std::string> {
+    static void encode(std::vector<char>& out, const std::string& value) {
+        if (value.size() > UINT32_MAX) {
+            throw std::length_error("ListCodec<std::string>: string too long to encode");
+        }
+        auto length = static_cast<std::uint32_t>(value.size());
+        const char* bytes = reinterpret_cast<const char*>(&length);
+        out.insert(out.end(), bytes, bytes + sizeof(length));
+        out.insert(out.end(), value.begin(), value.end());
+    }
+
+    static std::string decode(const char*& in, const char* end) {
+        std::uint32_t length;
+        if (end - in < static_cast<std::ptrdiff_t>(sizeof(length))) {
+            throw std::runtime_error("ListCodec<std::string>: truncated length");
+        }
+        std::memcpy(&length, in, sizeof(length));
+        in += sizeof(length);
+        if (static_cast<std::size_t>(end - in) < length) {
+            throw std::runtime_error("ListCodec<std::string>: truncated string");
+        }
+        std::string value(in, length);
+        in += length;
+        return value;
+    }
+};
+
+// what writer and reader agree on
+template <typename T>
+struct ListFormat {
+    static constexpr bool raw = std::is_trivially_copyable_v<T>;
+    static constexpr char magic[8] = { 'M', 'y', 'L', 'i', 's', 't', '\0', '\1' };
+    // a chunk is cut once it holds this many bytes
+    static constexpr std::size_t chunkBytes = std::size_t{ 1 } << 16;
+    // a reader refuses longer chunks, which bounds its buffer, so write()
+    // refuses an element whose encoding is longer
+    static constexpr std::uint32_t maxChunkBytes = std::uint32_t{ 1 } << 26;
+    // written after the magic: the element size, or 0 when a codec is used
+    static constexpr std::uint32_t elementSize = raw ? static_cast<std::uint32_t>(sizeof(T)) : 0;
+
+    struct ChunkHeader {
+        std::uint32_t count;
+        std::uint32_t bytes;
+    };
+};
+
+// Throws std::length_error, leaving the stream incomplete, if an element
+// encodes to more than maxChunkBytes.
+template <typename T, std::size_t N>
+void write(std::ostream& out, const MyList<T, N>& list) {
+    using Format = ListFormat<T>;
+    out.write(Format::magic, sizeof(Format::magic));
+    out.write(reinterpret_cast<const char*>(&Format::elementSize), sizeof(Format::elementSize));
+    std::vector<char> chunk;
+    chunk.reserve(Format::chunkBytes + (Format::raw ? 0 : Format::chunkBytes / 4));
+    std::uint32_t count = 0;
+    auto emit = [&] {
+        typename Format::ChunkHeader header{ count, static_cast<std::uint32_t>(chunk.size()) };
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        chunk.clear();
+        count = 0;
+    };
+    if constexpr (Format::raw) {
+        constexpr std::size_t perChunk = Format::chunkBytes / sizeof(T) > 0 ? Format::chunkBytes / sizeof(T) : 1;
+        chunk.resize(perChunk * sizeof(T));
+        char* at = chunk.data();
+        for (const T& value : list) {
+            std::memcpy(at, &value, sizeof(T));
+            at += sizeof(T);
+            if (++count == perChunk) {
+                emit();
+                chunk.resize(perChunk * sizeof(T));
+                at = chunk.data();
+            }
+        }
+        chunk.resize(count * sizeof(T));
+    }
+    else {
+        for (const T& value : list) {
+            std::size_t mark = chunk.size();
+            ListCodec<T>::encode(chunk, value);
+            if (chunk.size() - mark > Format::maxChunkBytes) {
+                throw std::length_error("write: element too large for one chunk");
+            }
+            // a large element goes into a chunk of its own rather than
+            // push the one before it over the limit
+            if (chunk.size() > Format::maxChunkBytes) {
+                std::vector<char> last(chunk.begin() + static_cast<std::ptrdiff_t>(mark), chunk.end());
+                chunk.resize(mark);
+                emit();
+                chunk.swap(last);
+            }
+            ++count;
+            if (chunk.size() >= Format::chunkBytes) {
+                emit();
+            }
+        }
+    }
+    if (count > 0) {
+        emit();
+    }
+    emit();
+    if (!out) {
+        throw std::runtime_error("write: output stream failed");
+    }
+}
+
+// Appends the elements of a stream made by write() to a list, one chunk
+// per read_chunk() call, holding no more than one chunk in memory.
+//
+// Another thread may walk the loaded part of the list while loading goes
+// on.  wait_for(k) returns once k elements are in (or loading has
+// stopped) and makes them visible to the calling thread.  It must not go
+// further than the count returned, not even to compare with end(): step
+// onto element k with std::next from element k - 1 (begin() for the
+// first), never past the last loaded one.  Nothing else may touch the
+// list until loading has stopped.
+template <typename T, std::size_t N = 0>
+class ListReader {
+public:
+    // reads and checks the stream header
+    ListReader(std::istream& in, MyList<T, N>& list);
+
+    // append the next chunk; false once the end of the stream is reached
+    bool read_chunk();
+    // read_chunk() until the end of the stream
+    void read_all();
+
+    // elements appended so far
+    int loaded() const;
+    // block until at least n elements are loaded or loading has stopped,
+    // and return how many are loaded
+    int wait_for(int n) const;
+    // whether loading has stopped, at the end of the stream or on an error
+    bool done() const;
+
+private:
+    using Format = ListFormat<T>;
+    static_assert(!Format::raw || alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                  "chunks are read into a buffer from plain operator new");
+
+    std::istream& in_;
+    MyList<T, N>& list_;
+    std::vector<char> chunk_;
+    mutable std::mutex lock_;
+    mutable std::condition_variable grown_;
+    int loaded_{ 0 };
+    bool done_{ false };
+
+    void read(char* into, std::size_t bytes);
+    void publish(bool finished);
+};
+
+template <typename T, std::size_t N>
+ListReader<T, N>::ListReader(std::istream& in, MyList<T, N>& list) : in_(in), list_(list) {
+    char magic[sizeof(Format::magic)];
+    std::uint32_t elementSize;
+    read(magic, sizeof(magic));
+    read(reinterpret_cast<char*>(&elementSize), sizeof(elementSize));
+    if (std::memcmp(magic, Format::magic, sizeof(magic)) != 0 || elementSize != Format::elementSize) {
+        throw std::runtime_error("ListReader: not a list of this element type");
+    }
+    loaded_ = list.size();
+}
+
+template <typename T, std::size_t N>
+bool ListReader<T, N>::read_chunk() {
+    if (done()) {
+        return false;
+    }
+    try {
+        typename Format::ChunkHeader header;
+        read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (header.count == 0) {
+            publish(true);
+            return false;
+        }
+        if (header.bytes > Format::maxChunkBytes || (Format::raw && header.bytes != header.count * sizeof(T))) {
+            throw std::runtime_error("ListReader: malformed chunk");
+        }
+        chunk_.resize(header.bytes);
+        read(chunk_.data(), header.bytes);
+        if constexpr (Format::raw) {
+            // the buffer is suitably aligned for any T, and its bytes are Ts
+            const T* first = reinterpret_cast<const T*>(chunk_.data());
+            list_.insert(list_.end(), first, first + header.count);
+        }
+        else {
+            const char* at = chunk_.data();
+            const char* end = at + chunk_.size();
+            for (std::uint32_t i = 0; i < header.count; ++i) {
+                list_.emplace_back(ListCodec<T>::decode(at, end));
+            }
+            if (at != end) {
+                throw std::runtime_error("ListReader: malformed chunk");
+            }
+        }
+    }
+    catch (...) {
+        publish(true);
+        throw;
+    }
+    publish(false);
+    return true;
+}
+
+template <typename T, std::size_t N>
+void ListReader<T, N>::read_all() {
+    while (read_chunk()) {
+    }
+}
+
+template <typename T, std::size_t N>
+int ListReader<T, N>::loaded() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    return loaded_;
+}
+
+template <typename T, std::size_t N>
+int ListReader<T, N>::wait_for(int n) const {
+    std::unique_lock<std::mutex> held(lock_);
+    grown_.wait(held, [&] { return loaded_ >= n || done_; });
+    return loaded_;
+}
+
+template <typename T, std::size_t N>
+bool ListReader<T, N>::done() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    return done_;
+}
+
+template <typename T, std::size_t N>
+void ListReader<T, N>::read(char* into, std::size_t bytes) {
+    if (!in_.read(into, static_cast<std::streamsize>(bytes))) {
+        throw std::runtime_error("ListReader: stream ended early");
+    }
+}
+
+// the lock orders the appends before a waiter's walk over them
+template <typename T, std::size_t N>
+void ListReader<T, N>::publish(bool finished) {
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        loaded_ = list_.size();
+        done_ = done_ || finished;
+    }
+    grown_.notify_all();
+}
+
+#endif // LIST_STREAM_HPP_
@@ -0,0 +1,298 @@
+#ifndef LOCK_COUPLING_LIST_HPP_
+#define LOCK_COUPLING_LIST_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+// Thread-safe doubly linked list with a mutex in every node.
+// A link is guarded by the locks of both nodes it joins: insert(pos) locks
+// pos and its predecessor, erase(pos) locks pos and both neighbours, and
+// traversal moves hand over hand, taking the next node's lock before
+// letting go of the current one.  Threads working in different parts of
+// the list therefore never wait for each other.
+//
+// Only the first lock of an operation is waited for; the neighbours are
+// tried, and on failure everything is let go and the operation starts
+// over.  That rules out deadlock even though the list is circular and
+// operations lock in both directions.
+//
+// As with MyList, inserting invalidates no iterator and erasing
+// invalidates only the erased element's.  The caller must not erase an
+// element while another thread may still use it (including as the
+// position of an insert), and reading or writing an element's value is
+// the caller's own business to synchronise.
+template <typename T>
+class LockCouplingList {
+public:
+    struct NodeBase {
+        NodeBase* prev{ nullptr };
+        NodeBase* next{ nullptr };
+        std::mutex lock;
+    };
+
+    struct Node : NodeBase {
+        T data;
+        template <typename... Args>
+        explicit Node(Args&&... args) : data(std::forward<Args>(args)...) {}
+    };
+
+    // stepping locks the node stepped from, so it is safe while other
+    // threads relink around it
+    class Iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        NodeBase* current_{ nullptr };
+
+        Iterator() = default;
+        explicit Iterator(NodeBase* node) : current_(node) {}
+
+        Iterator& operator++() {
+            std::lock_guard<std::mutex> guard(current_->lock);
+            current_ = current_->next;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        Iterator& operator--() {
+            std::lock_guard<std::mutex> guard(current_->lock);
+            current_ = current_->prev;
+            return *this;
+        }
+
+        Iterator operator--(int) {
+            Iterator old = *this;
+            --*this;
+            return old;
+        }
+
+        T& operator*() const {
+            return static_cast<Node*>(current_)->data;
+        }
+
+        T* operator->() const {
+            return &**this;
+        }
+
+        friend bool operator==(const Iterator& a, const Iterator& b) {
+            return a.current_ == b.current_;
+        }
+
+        friend bool operator!=(const Iterator& a, const Iterator& b) {
+            return !(a == b);
+        }
+    };
+
+private:
+    NodeBase endnode;
+
+    std::atomic<int> size_;
+
+public:
+    LockCouplingList();
+    LockCouplingList(const LockCouplingList&) = delete;
+    LockCouplingList& operator=(const LockCouplingList&) = delete;
+    // no other thread may be using the list any more
+    ~LockCouplingList();
+
+    void push_front(const T& value);
+    void push_back(const T& value);
+    Iterator insert(const Iterator& position, const T& value);
+    template <typename... Args>
+    Iterator emplace(const Iterator& position, Args&&... args);
+    void erase(const Iterator& position);
+
+    // visit every element hand over hand; f runs under the element's lock
+    template <typename F>
+    void for_each(F f);
+    // first element satisfying pred, or end()
+    template <typename Pred>
+    Iterator find_if(Pred pred);
+
+    bool empty() const;
+    int size() const;
+
+    Iterator begin();
+    Iterator end();
+
+private:
+    static void backOff(std::unique_lock<std::mutex>& held);
+    void link(NodeBase* prev, NodeBase* next, Node* node);
+};
+
+template <typename T>
+LockCouplingList<T>::LockCouplingList() : size_{ 0 } {
+    endnode.prev = &endnode;
+    endnode.next = &endnode;
+}
+
+template <typename T>
+LockCouplingList<T>::~LockCouplingList() {
+    for (NodeBase* current = endnode.next; current != &endnode;) {
+        NodeBase* next = current->next;
+        delete static_cast<Node*>(current);
+        current = next;
+    }
+}
+
+// locks the sentinel and then its successor, the reverse of insert's order
+template <typename T>
+void LockCouplingList<T>::push_front(const T& value) {
+    Node* node = new Node(value);
+    for (;;) {
+        std::unique_lock<std::mutex> head(endnode.lock);
+        NodeBase* first = endnode.next;
+        if (first == &endnode) {
+            link(&endnode, &endnode, node);
+            return;
+        }
+        std::unique_lock<std::mutex> next(first->lock, std::try_to_lock);
+        if (next.owns_lock()) {
+            link(&endnode, first, node);
+            return;
+        }
+        backOff(head);
+    }
+}
+
+template <typename T>
+void LockCouplingList<T>::push_back(const T& value) {
+    emplace(end(), value);
+}
+
+template <typename T>
+typename LockCouplingList<T>::Iterator LockCouplingList<T>::insert(const Iterator& position, const T& value) {
+    return emplace(position, value);
+}
+
+template <typename T>
+template <typename... Args>
+typename LockCouplingList<T>::Iterator LockCouplingList<T>::emplace(const Iterator& position, Args&&... args) {
+    Node* node = new Node(std::forward<Args>(args)...);
+    NodeBase* next = position.current_;
+    for (;;) {
+        std::unique_lock<std::mutex> at(next->lock);
+        // prev cannot change while next is held
+        NodeBase* prev = next->prev;
+        if (prev == next) {
+            link(next, next, node);
+            return Iterator(node);
+        }
+        std::unique_lock<std::mutex> before(prev->lock, std::try_to_lock);
+        if (before.owns_lock()) {
+            link(prev, next, node);
+            return Iterator(node);
+        }
+        backOff(at);
+    }
+}
+
+template <typename T>
+void LockCouplingList<T>::erase(const Iterator& position) {
+    NodeBase* node = position.current_;
+    for (;;) {
+        std::unique_lock<std::mutex> at(node->lock);
+        NodeBase* prev = node->prev;
+        NodeBase* next = node->next;
+        std::unique_lock<std::mutex> before(prev->lock, std::try_to_lock);
+        if (!before.owns_lock()) {
+            backOff(at);
+            continue;
+        }
+        // with a single element both neighbours are the sentinel
+        std::unique_lock<std::mutex> after;
+        if (next != prev) {
+            after = std::unique_lock<std::mutex>(next->lock, std::try_to_lock);
+            if (!after.owns_lock()) {
+                before.unlock();
+                backOff(at);
+                continue;
+            }
+        }
+        prev->next = next;
+        next->prev = prev;
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        at.unlock();
+        delete static_cast<Node*>(node);
+        return;
+    }
+}
+
+template <typename T>
+template <typename F>
+void LockCouplingList<T>::for_each(F f) {
+    std::unique_lock<std::mutex> held(endnode.lock);
+    for (NodeBase* current = endnode.next; current != &endnode;) {
+        std::unique_lock<std::mutex> next(current->lock);
+        held = std::move(next);
+        f(static_cast<Node*>(current)->data);
+        current = current->next;
+    }
+}
+
+template <typename T>
+template <typename Pred>
+typename LockCouplingList<T>::Iterator LockCouplingList<T>::find_if(Pred pred) {
+    std::unique_lock<std::mutex> held(endnode.lock);
+    for (NodeBase* current = endnode.next; current != &endnode;) {
+        std::unique_lock<std::mutex> next(current->lock);
+        held = std::move(next);
+        if (pred(static_cast<const Node*>(current)->data)) {
+            return Iterator(current);
+        }
+        current = current->next;
+    }
+    return end();
+}
+
+template <typename T>
+bool LockCouplingList<T>::empty() const {
+    return size() == 0;
+}
+
+template <typename T>
+int LockCouplingList<T>::size() const {
+    return size_.load(std::memory_order_relaxed);
+}
+
+template <typename T>
+typename LockCouplingList<T>::Iterator LockCouplingList<T>::begin() {
+    return ++end();
+}
+
+template <typename T>
+typename LockCouplingList<T>::Iterator LockCouplingList<T>::end() {
+    return Iterator(&endnode);
+}
+
+// give up the lock that was waited for and let the thread in the way finish
+template <typename T>
+void LockCouplingList<T>::backOff(std::unique_lock<std::mutex>& held) {
+    held.unlock();
+    std::this_thread::yield();
+}
+
+// prev and next are locked by the caller (the same node when the list is empty)
+template <typename T>
+void LockCouplingList<T>::link(NodeBase* prev, NodeBase* next, Node* node) {
+    node->prev = prev;
+    node->next = next;
+    prev->next = node;
+    next->prev = node;
+    size_.fetch_add(1, std::memory_order_relaxed);
+}
+
+#endif // LOCK_COUPLING_LIST_HPP_
@@ -0,0 +1,316 @@
+#ifndef LRU_CACHE_HPP_
+#define LRU_CACHE_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "myList.hpp"
+
+// Least-recently-used cache: a MyList in recency order (front is the most
+// recent) plus an open-addressing hash table from key to list node.
+//
+// A hit is a table probe and a splice of the node to the front, so it
+// never allocates.  When a put has to evict, the least recent node is
+// overwritten with the new entry and spliced to the front instead of being
+// freed and allocated again.
+//
+// Capacity is a total weight.  By default each entry weighs 1, so capacity
+// counts entries; pass a weigh function (for example one returning the
+// bytes a key and value occupy) to bound memory instead.  An entry heavier
+// than the whole capacity is not cached.
+template <typename K, typename V, typename Hash = std::hash<K>>
+class LruCache {
+public:
+    using Weigh = std::function<std::size_t(const K&, const V&)>;
+
+private:
+    struct Entry {
+        K key;
+        V value;
+        std::size_t weight;
+        Entry(const K& k, V v, std::size_t w) : key(k), value(std::move(v)), weight{ w } {}
+    };
+
+    using List = MyList<Entry>;
+    using Position = typename List::Iterator;
+
+    // a table slot is empty when its node is null
+    struct Slot {
+        Position node{};
+        std::size_t hash{ 0 };
+    };
+
+    List recency_;
+    std::vector<Slot> table_;
+    std::size_t mask_;
+    std::size_t weight_;
+    std::size_t capacity_;
+    Weigh weigh_;
+    Hash hasher_;
+
+public:
+    explicit LruCache(std::size_t capacity);
+    LruCache(std::size_t capacity, Weigh weigh);
+    // the table points at list nodes, which a copy would not share; a move
+    // keeps the nodes where they are and leaves other an empty cache of the
+    // same capacity, weighing each entry 1
+    LruCache(const LruCache&) = delete;
+    LruCache& operator=(const LruCache&) = delete;
+    LruCache(LruCache&& other);
+    LruCache& operator=(LruCache&& other);
+
+    // the cached value for key, now the most recent entry; null on a miss
+    V* get(const K& key);
+    // insert or overwrite key, making it the most recent entry
+    void put(const K& key, const V& value);
+    void put(const K& key, V&& value);
+
+    // lookup without touching recency
+    bool contains(const K& key) const;
+    bool erase(const K& key);
+
+    int size() const;
+    std::size_t weight() const;
+    std::size_t capacity() const;
+
+    void clear();
+
+private:
+    template <typename Value>
+    void store(const K& key, Value&& value);
+    std::size_t hashOf(const K& key) const;
+    std::size_t find(const K& key, std::size_t hash) const;
+    void index(Position node, std::size_t hash);
+    void unindex(std::size_t slot);
+    void grow();
+    void reset();
+    static std::size_t unitWeight(const K&, const V&);
+};
+
+template <typename K, typename V, typename Hash>
+LruCache<K, V, Hash>::LruCache(std::size_t capacity) : LruCache(capacity, &unitWeight) {}
+
+template <typename K, typename V, typename Hash>
+LruCache<K, V, Hash>::LruCache(std::size_t capacity, Weigh weigh)
+    : table_(16), mask_{ 15 }, weight_{ 0 }, capacity_{ capacity }, weigh_{ std::move(weigh) } {}
+
+template <typename K, typename V, typename Hash>
+LruCache<K, V, Hash>::LruCache(LruCache&& other)
+    : recency_(std::move(other.recency_)), table_(std::move(other.table_)), mask_{ other.mask_ },
+      weight_{ other.weight_ }, capacity_{ other.capacity_ }, weigh_(std::move(other.weigh_)),
+      hasher_(std::move(other.hasher_)) {
+    other.reset();
+}
+
+template <typename K, typename V, typename Hash>
+LruCache<K, V, Hash>& LruCache<K, V, Hash>::operator=(LruCache&& other) {
+    if (this != &other) {
+        recency_ = std::move(other.recency_);
+        table_ = std::move(other.table_);
+        mask_ = other.mask_;
+        weight_ = other.weight_;
+        capacity_ = other.capacity_;
+        weigh_ = std::move(other.weigh_);
+        hasher_ = std::move(other.hasher_);
+        other.reset();
+    }
+    return *this;
+}
+
+template <typename K, typename V, typename Hash>
+V* LruCache<K, V, Hash>::get(const K& key) {
+    std::size_t slot = find(key, hashOf(key));
+    if (slot == table_.size()) {
+        return nullptr;
+    }
+    Position node = table_[slot].node;
+    recency_.splice(recency_.begin(), recency_, node);
+    return &node->value;
+}
+
+template <typename K, typename V, typename Hash>
+void LruCache<K, V, Hash>::put(const K& key, const V& value) {
+    store(key, value);
+}
+
+template <typename K, typename V, typename Hash>
+void LruCache<K, V, Hash>::put(const K& key, V&& value) {
+    store(key, std::move(value));
+}
+
+template <typename K, typename V, typename Hash>
+bool LruCache<K, V, Hash>::contains(const K& key) const {
+    return find(key, hashOf(key)) != table_.size();
+}
+
+template <typename K, typename V, typename Hash>
+bool LruCache<K, V, Hash>::erase(const K& key) {
+    std::size_t slot = find(key, hashOf(key));
+    if (slot == table_.size()) {
+        return false;
+    }
+    Position node = table_[slot].node;
+    weight_ -= node->weight;
+    unindex(slot);
+    recency_.erase(node);
+    return true;
+}
+
+template <typename K, typename V, typename Hash>
+int LruCache<K, V, Hash>::size() const {
+    return recency_.size();
+}
+
+template <typename K, typename V, typename Hash>
+std::size_t LruCache<K, V, Hash>::weight() const {
+    return weight_;
+}
+
+template <typename K, typename V, typename Hash>
+std::size_t LruCache<K, V, Hash>::capacity() const {
+    return capacity_;
+}
+
+template <typename K, typename V, typename Hash>
+void LruCache<K, V, Hash>::clear() {
+    recency_.clear();
+    for (auto& slot : table_) {
+        slot = Slot{};
+    }
+    weight_ = 0;
+}
+
+template <typename K, typename V, typename Hash>
+template <typename Value>
+void LruCache<K, V, Hash>::store(const K& key, Value&& value) {
+    std::size_t hash = hashOf(key);
+    std::size_t weight = weigh_(key, value);
+    if (weight > capacity_) {
+        erase(key);
+        return;
+    }
+
+    std::size_t slot = find(key, hash);
+    if (slot != table_.size()) {
+        Position node = table_[slot].node;
+        node->value = std::forward<Value>(value);
+        weight_ += weight - node->weight;
+        node->weight = weight;
+        recency_.splice(recency_.begin(), recency_, node);
+    }
+    else {
+        // evict from the cold end until the new entry fits; the last node
+        // evicted is kept and becomes the new entry
+        Position reuse{};
+        while (!recency_.empty() && weight_ + weight > capacity_) {
+            if (reuse != Position{}) {
+                recency_.erase(reuse);
+            }
+            reuse = --recency_.end();
+            weight_ -= reuse->weight;
+            unindex(find(reuse->key, hashOf(reuse->key)));
+        }
+        if (reuse != Position{}) {
+            reuse->key = key;
+            reuse->value = std::forward<Value>(value);
+            reuse->weight = weight;
+            recency_.splice(recency_.begin(), recency_, reuse);
+        }
+        else {
+            recency_.emplace_front(key, std::forward<Value>(value), weight);
+        }
+        weight_ += weight;
+        index(recency_.begin(), hash);
+        return;
+    }
+
+    // an overwrite may have grown the entry past capacity
+    while (weight_ > capacity_) {
+        Position cold = --recency_.end();
+        weight_ -= cold->weight;
+        unindex(find(cold->key, hashOf(cold->key)));
+        recency_.erase(cold);
+    }
+}
+
+// std::hash is often the identity on integers, so spread the bits before
+// masking to a power-of-two table
+template <typename K, typename V, typename Hash>
+std::size_t LruCache<K, V, Hash>::hashOf(const K& key) const {
+    std::size_t h = hasher_(key) * static_cast<std::size_t>(0x9E3779B97F4A7C15ull);
+    return h ^ (h >> (sizeof(std::size_t) * 4));
+}
+
+// slot holding key, or table_.size() if key is absent
+template <typename K, typename V, typename Hash>
+std::size_t LruCache<K, V, Hash>::find(const K& key, std::size_t hash) const {
+    for (std::size_t i = hash & mask_; table_[i].node != Position{}; i = (i + 1) & mask_) {
+        if (table_[i].hash == hash && table_[i].node->key == key) {
+            return i;
+        }
+    }
+    return table_.size();
+}
+
+template <typename K, typename V, typename Hash>
+void LruCache<K, V, Hash>::index(Position node, std::size_t hash) {
+    if ((static_cast<std::size_t>(recency_.size()) + 1) * 2 > table_.size()) {
+        grow();
+    }
+    std::size_t i = hash & mask_;
+    while (table_[i].node != Position{}) {
+        i = (i + 1) & mask_;
+    }
+    table_[i] = Slot{ node, hash };
+}
+
+// linear-probing delete: pull later entries of the same probe run back
+// into the hole so that no lookup stops short at it
+template <typename K, typename V, typename Hash>
+void LruCache<K, V, Hash>::unindex(std::size_t slot) {
+    std::size_t hole = slot;
+    for (std::size_t i = (hole + 1) & mask_; table_[i].node != Position{}; i = (i + 1) & mask_) {
+        std::size_t home = table_[i].hash & mask_;
+        // entry i may move into the hole unless its home lies in (hole, i]
+        bool stays = hole < i ? (home > hole && home <= i) : (home > hole || home <= i);
+        if (!stays) {
+            table_[hole] = table_[i];
+            hole = i;
+        }
+    }
+    table_[hole] = Slot{};
+}
+
+template <typename K, typename V, typename Hash>
+void LruCache<K, V, Hash>::grow() {
+    std::vector<Slot> old(table_.size() * 2);
+    old.swap(table_);
+    mask_ = table_.size() - 1;
+    for (const auto& slot : old) {
+        if (slot.node != Position{}) {
+            std::size_t i = slot.hash & mask_;
+            while (table_[i].node != Position{}) {
+                i = (i + 1) & mask_;
+            }
+            table_[i] = slot;
+        }
+    }
+}
+
+// what a moved-from cache is left as: empty, with a table to probe
+template <typename K, typename V, typename Hash>
+void LruCache<K, V, Hash>::reset() {
+    recency_.clear();
+    table_.assign(16, Slot{});
+    mask_ = 15;
+    weight_ = 0;
+    weigh_ = &unitWeight;
+}
+
+template <typename K, typename V, typename Hash>
+std::size_t LruCache<K, V, Hash>::unitWeight(const K&, const V&) {
+    return 1;
+}
+
+#endif // LRU_CACHE_HPP_
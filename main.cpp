@@ -4,7 +4,32 @@
 #include <algorithm>
 #include <string>
 #include <list>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <sstream>
+#include <fstream>
+#include <numeric>
+#include <filesystem>
+#include <memory>
 #include "myList.hpp"
+#include "unrolledList.hpp"
+#include "intrusiveList.hpp"
+#include "indexedList.hpp"
+#include "rankedList.hpp"
+#include "orderedList.hpp"
+#include "lruCache.hpp"
+#include "concurrentQueue.hpp"
+#include "concurrentSet.hpp"
+#include "rcuList.hpp"
+#include "lockCouplingList.hpp"
+#include "parallelList.hpp"
+#include "persistentList.hpp"
+#ifndef _WIN32
+#include "mappedList.hpp"
+#endif
+#include "listStream.hpp"
 #include "myInteger.hpp"
 
 TEST(List, smallIncrementIterator) {
@@ -245,6 +270,1795 @@ TEST(List, noIteratorInvalidationErase) {
   EXPECT_EQ(*it_last, MyInteger {2});
 }
 
+TEST(List, poolRecyclesFreedNodes) {
+  auto pool = std::make_shared<MyList<int>::Pool>();
+  MyList<int> li {pool};
+  for (int i = 0; i < 100; ++i) {
+    li.push_back(i);
+  }
+  std::size_t blocks = pool->blockCount();
+  for (int i = 0; i < 100000; ++i) {
+    li.push_back(i);
+    li.pop_front();
+  }
+  EXPECT_EQ(pool->blockCount(), blocks);
+  EXPECT_EQ(li.size(), 100);
+  EXPECT_EQ(li.back(), 99999);
+}
+
+TEST(List, clearThenReuse) {
+  MyList<std::string> li {"a", "b", "c"};
+  li.clear();
+  EXPECT_TRUE(li.empty());
+  li.push_back("d");
+  li.push_front("c");
+  EXPECT_EQ(li.size(), 2);
+  EXPECT_EQ(li.front(), "c");
+  EXPECT_EQ(li.back(), "d");
+}
+
+TEST(List, sharedPool) {
+  auto pool = std::make_shared<MyList<std::string>::Pool>();
+  MyList<std::string> a {pool};
+  {
+    MyList<std::string> b {pool};
+    for (int i = 0; i < 50; ++i) {
+      a.push_back(std::to_string(i));
+      b.push_back(std::to_string(-i));
+    }
+    b.clear();
+    EXPECT_TRUE(b.empty());
+  }
+  int i = 0;
+  for (const auto& x : a) {
+    EXPECT_EQ(x, std::to_string(i++));
+  }
+  EXPECT_EQ(i, 50);
+}
+
+TEST(List, pushTemporaryDoesNotCopy) {
+  MyList<MyInteger> li {};
+  MyInteger::clearCounts();
+  li.push_back(MyInteger {1});
+  li.push_front(MyInteger {0});
+  li.insert(li.end(), MyInteger {2});
+  EXPECT_EQ(MyInteger::copyCount, 0);
+  EXPECT_EQ(MyInteger::moveCount, 3);
+  MyInteger::clearCounts();
+  li.emplace_back(4);
+  li.emplace(--li.end(), 3);
+  li.emplace_front(-1);
+  EXPECT_EQ(MyInteger::copyCount, 0);
+  EXPECT_EQ(MyInteger::moveCount, 0);
+  EXPECT_EQ(MyInteger::constructorCount, 3);
+  int i = -1;
+  for (const auto& x : li) {
+    EXPECT_EQ(x, MyInteger {i++});
+  }
+  EXPECT_EQ(i, 5);
+}
+
+TEST(List, emplaceReturnsIterator) {
+  MyList<std::string> li {"a", "c"};
+  auto it = li.emplace(--li.end(), 1, 'b');
+  EXPECT_EQ(*it, "b");
+  ++it;
+  EXPECT_EQ(*it, "c");
+  EXPECT_EQ(li.emplace_back(3, 'd'), "ddd");
+  EXPECT_EQ(li.size(), 4);
+}
+
+TEST(List, moveConstructorStealsNodes) {
+  MyList<std::string> a {"Hello", "How", "Are", "You"};
+  const std::string* first = &a.front();
+  MyList<std::string> b {std::move(a)};
+  EXPECT_EQ(&b.front(), first);
+  EXPECT_EQ(b.size(), 4);
+  EXPECT_TRUE(a.empty());
+  a.push_back("again");
+  EXPECT_EQ(a.front(), "again");
+  EXPECT_EQ(a.size(), 1);
+}
+
+TEST(List, moveAssignment) {
+  MyList<std::string> a {"x", "y"};
+  MyList<std::string> b {"old"};
+  const std::string* last = &a.back();
+  b = std::move(a);
+  EXPECT_EQ(&b.back(), last);
+  EXPECT_EQ(b.size(), 2);
+  MyList<std::string> c {};
+  c = b;
+  EXPECT_EQ(c.size(), 2);
+  EXPECT_EQ(c.front(), "x");
+  EXPECT_NE(&c.back(), last);
+  c = c;
+  EXPECT_EQ(c.size(), 2);
+}
+
+TEST(List, emptyListBeginIsEnd) {
+  const MyList<int> li {};
+  EXPECT_EQ(li.begin(), li.end());
+  EXPECT_EQ(li.rbegin(), li.rend());
+}
+
+TEST(List, constIteration) {
+  const MyList<int> li {1, 2, 3};
+  int i = 1;
+  for (auto it = li.cbegin(); it != li.cend(); ++it) {
+    EXPECT_EQ(*it, i++);
+  }
+  MyList<int> mutableList {4, 5};
+  MyList<int>::ConstIterator it = mutableList.begin();
+  EXPECT_EQ(*it, 4);
+  EXPECT_EQ(it, mutableList.cbegin());
+}
+
+TEST(List, reverseIterators) {
+  MyList<std::string> li {"a", "b", "c"};
+  std::string joined {};
+  for (auto it = li.rbegin(); it != li.rend(); ++it) {
+    joined += *it;
+  }
+  EXPECT_EQ(joined, "cba");
+  *li.rbegin() = "z";
+  EXPECT_EQ(li.back(), "z");
+}
+
+TEST(List, insertIntoEmptyAndEraseLast) {
+  MyList<int> li {};
+  li.insert(li.end(), 7);
+  EXPECT_EQ(li.front(), 7);
+  EXPECT_EQ(li.back(), 7);
+  li.erase(li.begin());
+  EXPECT_TRUE(li.empty());
+  EXPECT_EQ(li.begin(), li.end());
+  li.push_front(1);
+  li.insert(li.end(), 2);
+  int i = 1;
+  for (int x : li) {
+    EXPECT_EQ(x, i++);
+  }
+  EXPECT_EQ(i, 3);
+}
+
+TEST(List, spliceWholeList) {
+  MyList<std::string> a {"a", "d"};
+  MyList<std::string> b {"b", "c"};
+  const std::string* b0 = &b.front();
+  a.splice(++a.begin(), b);
+  EXPECT_TRUE(b.empty());
+  EXPECT_EQ(a.size(), 4);
+  auto it = a.begin();
+  ++it;
+  EXPECT_EQ(&*it, b0);
+  std::string joined {};
+  for (const auto& x : a) {
+    joined += x;
+  }
+  EXPECT_EQ(joined, "abcd");
+  b.push_back("e");
+  a.splice(a.end(), std::move(b));
+  EXPECT_EQ(a.back(), "e");
+}
+
+TEST(List, spliceSingleAndRange) {
+  MyList<int> a {1, 5};
+  MyList<int> b {2, 3, 4, 6};
+  auto six = --b.end();
+  a.splice(a.end(), b, six);
+  EXPECT_EQ(a.back(), 6);
+  EXPECT_EQ(b.size(), 3);
+  auto five = --(--a.end());
+  a.splice(five, b, b.begin(), b.end());
+  EXPECT_TRUE(b.empty());
+  int i = 1;
+  for (int x : a) {
+    EXPECT_EQ(x, i++);
+  }
+  EXPECT_EQ(a.size(), 6);
+  // within one list: move the first node to the back
+  a.splice(a.end(), a, a.begin());
+  EXPECT_EQ(a.front(), 2);
+  EXPECT_EQ(a.back(), 1);
+  EXPECT_EQ(a.size(), 6);
+}
+
+TEST(List, splicedNodesOutliveSourceList) {
+  MyList<std::string> a {"keep"};
+  {
+    MyList<std::string> b {};
+    for (int i = 0; i < 100; ++i) {
+      b.push_back(std::to_string(i));
+    }
+    a.splice(a.end(), b, ++b.begin(), b.end());
+    EXPECT_EQ(b.size(), 1);
+  }
+  EXPECT_EQ(a.size(), 100);
+  EXPECT_EQ(a.back(), "99");
+  a.clear();
+  a.push_back("again");
+  EXPECT_EQ(a.front(), "again");
+}
+
+TEST(List, mergeIsStable) {
+  using Pair = std::pair<int, char>;
+  auto byKey = [](const Pair& x, const Pair& y) { return x.first < y.first; };
+  MyList<Pair> a {{1, 'a'}, {3, 'a'}, {5, 'a'}};
+  MyList<Pair> b {{1, 'b'}, {2, 'b'}, {5, 'b'}, {7, 'b'}};
+  a.merge(b, byKey);
+  EXPECT_TRUE(b.empty());
+  std::vector<Pair> expected {{1, 'a'}, {1, 'b'}, {2, 'b'}, {3, 'a'}, {5, 'a'}, {5, 'b'}, {7, 'b'}};
+  std::size_t i = 0;
+  for (const auto& x : a) {
+    EXPECT_EQ(x, expected.at(i++));
+  }
+  EXPECT_EQ(a.size(), 7);
+}
+
+TEST(List, sortIsStableAndCopyFree) {
+  std::mt19937 mt {7};
+  MyList<MyInteger> li {};
+  std::vector<std::pair<int, int>> expected {};
+  for (int i = 0; i < 1000; ++i) {
+    int key = static_cast<int>(mt() % 50);
+    li.emplace_back(key * 1000 + i);
+    expected.emplace_back(key, i);
+  }
+  std::stable_sort(expected.begin(), expected.end(),
+                   [](const auto& x, const auto& y) { return x.first < y.first; });
+  MyInteger::clearCounts();
+  li.sort([](const MyInteger& x, const MyInteger& y) { return x.get() / 1000 < y.get() / 1000; });
+  EXPECT_EQ(MyInteger::copyCount, 0);
+  EXPECT_EQ(MyInteger::moveCount, 0);
+  std::size_t i = 0;
+  for (const auto& x : li) {
+    EXPECT_EQ(x.get(), expected.at(i).first * 1000 + expected.at(i).second);
+    ++i;
+  }
+  int n = 0;
+  for (auto it = li.end(); it != li.begin(); --it) {
+    ++n;
+  }
+  EXPECT_EQ(n, 1000);
+}
+
+TEST(List, sortStrings) {
+  MyList<std::string> li {"pear", "apple", "fig", "kiwi", "banana"};
+  li.sort();
+  std::vector<std::string> expected {"apple", "banana", "fig", "kiwi", "pear"};
+  std::size_t i = 0;
+  for (const auto& x : li) {
+    EXPECT_EQ(x, expected.at(i++));
+  }
+  EXPECT_EQ(li.back(), "pear");
+}
+
+TEST(List, bulkWalks) {
+  MyList<int> empty {};
+  EXPECT_EQ(empty.accumulate(0), 0);
+  EXPECT_EQ(empty.find_if([](int) { return true; }), empty.end());
+  for (int distance : {0, 1, 3, 8, 1000}) {
+    MyList<int> li {};
+    for (int i = 1; i <= 103; ++i) {
+      li.push_back(i);
+    }
+    li.for_each([](int& x) { x *= 2; }, distance);
+    EXPECT_EQ(li.accumulate(0LL, std::plus<>(), distance), 103LL * 104);
+    EXPECT_EQ(li.count_if([](int x) { return x % 3 == 0; }), 34);
+    auto it = li.find_if([](int x) { return x > 150; }, distance);
+    ASSERT_NE(it, li.end());
+    EXPECT_EQ(*it, 152);
+    const MyList<int>& view = li;
+    EXPECT_EQ(view.find_if([](int x) { return x < 0; }, distance), view.end());
+    EXPECT_EQ(*view.find_if([](int x) { return x == 206; }, distance), 206);
+  }
+  MyList<std::string> words {"a", "bb", "ccc"};
+  EXPECT_EQ(words.accumulate(std::string {}), "abbccc");
+  EXPECT_EQ(words.count_if([](const std::string& w) { return w.size() > 1; }), 2);
+  words.pop_back();
+  EXPECT_EQ(words.count_if([](const std::string& w) { return w.size() > 1; }), 1);
+}
+
+// true when the nodes of li sit at increasing addresses in list order
+template <typename T>
+bool inMemoryOrder(MyList<T>& li) {
+  const T* last = nullptr;
+  for (auto& x : li) {
+    if (last != nullptr && &x < last) {
+      return false;
+    }
+    last = &x;
+  }
+  return true;
+}
+
+TEST(List, compact) {
+  MyList<std::string> li {};
+  std::vector<std::string> expected {};
+  std::mt19937 mt {11};
+  for (int i = 0; i < 2000; ++i) {
+    auto it = std::next(li.begin(), static_cast<int>(mt() % (li.size() + 1)));
+    li.insert(it, std::to_string(i));
+  }
+  for (int i = 0; i < 500; ++i) {
+    li.erase(std::next(li.begin(), static_cast<int>(mt() % li.size())));
+  }
+  expected.assign(li.begin(), li.end());
+  EXPECT_FALSE(inMemoryOrder(li));
+  li.compact();
+  EXPECT_TRUE(inMemoryOrder(li));
+  EXPECT_EQ(std::vector<std::string>(li.begin(), li.end()), expected);
+  li.compact();
+  EXPECT_EQ(li.size(), 1500);
+  MyList<std::string> empty {};
+  empty.compact();
+  EXPECT_TRUE(empty.compact_step(1));
+}
+
+TEST(List, compactStepWithEdits) {
+  MyList<MyInteger> li {};
+  for (int i = 0; i < 300; ++i) {
+    li.push_front(MyInteger {i});
+  }
+  std::list<int> expected {};
+  for (const auto& x : li) {
+    expected.push_back(x.get());
+  }
+  int steps = 0;
+  std::mt19937 mt {12};
+  while (!li.compact_step(16)) {
+    ++steps;
+    // erase right at the front, which is where the cursor has been, and
+    // somewhere in the part still to move
+    li.pop_front();
+    expected.pop_front();
+    int k = static_cast<int>(mt() % li.size());
+    li.erase(std::next(li.begin(), k));
+    expected.erase(std::next(expected.begin(), k));
+    li.push_back(MyInteger {1000 + steps});
+    expected.push_back(1000 + steps);
+  }
+  EXPECT_GT(steps, 5);
+  ASSERT_EQ(li.size(), static_cast<int>(expected.size()));
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), li.begin(),
+                         [](int a, const MyInteger& b) { return a == b.get(); }));
+  // erasing the last unmoved node ends the compaction
+  EXPECT_FALSE(li.compact_step(li.size() - 1));
+  li.pop_back();
+  EXPECT_TRUE(inMemoryOrder(li));
+}
+
+TEST(List, compactCutShort) {
+  MyList<int> a {};
+  MyList<int> b {};
+  for (int i = 0; i < 100; ++i) {
+    a.push_back(i);
+    b.push_back(100 + i);
+  }
+  // share a's pool with b, then move half of a and splice from b
+  a.splice(a.end(), b, b.begin());
+  EXPECT_FALSE(a.compact_step(50));
+  b.splice(b.begin(), a, a.begin(), std::next(a.begin(), 10));
+  EXPECT_EQ(b.front(), 0);
+  EXPECT_FALSE(a.compact_step(20));
+  a.sort([](int x, int y) { return x > y; });
+  EXPECT_EQ(a.front(), 100);
+  a.compact();
+  b.compact();
+  EXPECT_TRUE(inMemoryOrder(a));
+  EXPECT_EQ(a.size() + b.size(), 200);
+  a.clear();
+  EXPECT_EQ(b.back(), 199);
+}
+
+struct Document {
+  std::string text {};
+  int key {};
+  char body[200] {};
+  Document(std::string t, int k) : text {std::move(t)}, key {k} {}
+  bool operator<(const Document& other) const {
+    return key < other.key;
+  }
+};
+
+template <>
+struct ListLayout<Document> {
+  static constexpr bool split = true;
+};
+
+TEST(List, splitLayout) {
+  static_assert(sizeof(MyList<Document>::Node) < sizeof(Document));
+  MyList<Document> li {};
+  for (int i = 0; i < 100; ++i) {
+    li.emplace_back(std::string(40, 'a' + i % 26), 99 - i);
+  }
+  auto it = std::next(li.begin(), 10);
+  EXPECT_EQ(it->key, 89);
+  li.sort();
+  EXPECT_EQ(li.front().key, 0);
+  EXPECT_EQ(it->key, 89);
+  EXPECT_EQ(it->text, std::string(40, 'k'));
+  // moving nodes across lists merges both halves of the pools
+  MyList<Document> other {};
+  other.emplace_back("x", 1000);
+  other.splice(other.begin(), li, it);
+  EXPECT_EQ(other.front().key, 89);
+  EXPECT_EQ(li.size(), 99);
+  li.erase(li.begin());
+  li.pop_back();
+  EXPECT_EQ(li.front().key, 1);
+  MyList<Document> copy {other};
+  EXPECT_EQ(copy.back().text, "x");
+  li.clear();
+  EXPECT_TRUE(li.empty());
+  li.emplace_back("again", 7);
+  EXPECT_EQ(li.front().text, "again");
+}
+
+// whether the element lives inside the list object itself
+template <typename T, std::size_t N>
+bool heldInline(const MyList<T, N>& li, const T& value) {
+  auto address = reinterpret_cast<const char*>(&value);
+  auto object = reinterpret_cast<const char*>(&li);
+  return address >= object && address < object + sizeof(li);
+}
+
+TEST(List, inlineNodes) {
+  MyList<std::string, 3> li {"a", "b", "c"};
+  for (const auto& s : li) {
+    EXPECT_TRUE(heldInline(li, s));
+  }
+  // the fourth spills to the pool; a freed slot is used again
+  li.push_back("d");
+  EXPECT_FALSE(heldInline(li, li.back()));
+  li.pop_front();
+  li.push_front("z");
+  EXPECT_TRUE(heldInline(li, li.front()));
+  EXPECT_EQ(std::vector<std::string>(li.begin(), li.end()), (std::vector<std::string> {"z", "b", "c", "d"}));
+  li.sort();
+  EXPECT_EQ(std::vector<std::string>(li.begin(), li.end()), (std::vector<std::string> {"b", "c", "d", "z"}));
+
+  // moving and swapping rebuild inline nodes in the receiving object
+  MyList<std::string, 3> moved {std::move(li)};
+  EXPECT_TRUE(li.empty());
+  EXPECT_EQ(std::vector<std::string>(moved.begin(), moved.end()), (std::vector<std::string> {"b", "c", "d", "z"}));
+  EXPECT_EQ(std::count_if(moved.begin(), moved.end(), [&](const std::string& s) { return heldInline(moved, s); }), 3);
+  MyList<std::string, 3> other {"x", "y"};
+  moved.swap(other);
+  EXPECT_EQ(std::vector<std::string>(other.begin(), other.end()), (std::vector<std::string> {"b", "c", "d", "z"}));
+  EXPECT_EQ(std::vector<std::string>(moved.begin(), moved.end()), (std::vector<std::string> {"x", "y"}));
+  // five inline nodes between two lists of three slots: two spill
+  EXPECT_EQ(std::count_if(other.begin(), other.end(), [&](const std::string& s) { return heldInline(other, s); }), 3);
+  EXPECT_EQ(std::count_if(moved.begin(), moved.end(), [&](const std::string& s) { return heldInline(moved, s); }), 0);
+
+  // nodes leaving by splice or merge cannot take their slots with them
+  moved.splice(moved.begin(), other, std::next(other.begin()), std::prev(other.end()));
+  EXPECT_EQ(std::vector<std::string>(moved.begin(), moved.end()), (std::vector<std::string> {"c", "d", "x", "y"}));
+  moved.splice(moved.end(), other, other.begin());
+  moved.merge(other);
+  EXPECT_TRUE(other.empty());
+  EXPECT_EQ(std::vector<std::string>(moved.begin(), moved.end()), (std::vector<std::string> {"c", "d", "x", "y", "b", "z"}));
+  for (const auto& s : moved) {
+    EXPECT_FALSE(heldInline(other, s));
+  }
+  other = moved;
+  EXPECT_EQ(other.size(), 6);
+  moved.clear();
+  EXPECT_TRUE(moved.empty());
+}
+
+// copying one whose value is poison throws
+struct Fragile {
+  int value;
+  static constexpr int poison = -1;
+  Fragile(int v) : value(v) {}
+  Fragile(const Fragile& other) : value(other.value) {
+    if (value == poison) {
+      throw std::runtime_error {"poison"};
+    }
+  }
+};
+
+TEST(List, rangeInsert) {
+  std::vector<int> source {1, 2, 3, 4, 5};
+  MyList<int> li(source.begin(), source.end());
+  EXPECT_EQ(std::vector<int>(li.begin(), li.end()), source);
+  // freed slots are not reused, so the copies land back to back in order
+  for (int i = 0; i < 3; ++i) {
+    li.pop_front();
+  }
+  auto it = li.insert(std::next(li.begin()), source.begin(), source.end());
+  EXPECT_EQ(*it, 1);
+  EXPECT_EQ(std::vector<int>(li.begin(), li.end()), (std::vector<int> {4, 1, 2, 3, 4, 5, 5}));
+  for (int i = 0; i < 4; ++i, ++it) {
+    EXPECT_EQ(&*std::next(it), &*it + sizeof(MyList<int>::Node) / sizeof(int));
+  }
+  EXPECT_EQ(li.insert(li.end(), source.end(), source.end()), li.end());
+
+  // single-pass input: nothing to reserve
+  std::istringstream in {"7 8 9"};
+  li.assign(std::istream_iterator<int> {in}, std::istream_iterator<int> {});
+  EXPECT_EQ(std::vector<int>(li.begin(), li.end()), (std::vector<int> {7, 8, 9}));
+  li.assign(source.begin(), source.begin() + 2);
+  EXPECT_EQ(li.size(), 2);
+  EXPECT_TRUE(inMemoryOrder(li));
+
+  // a throwing copy leaves the list as it was
+  std::vector<Fragile> fragile {};
+  fragile.reserve(4);
+  for (int v : {1, 2, Fragile::poison, 4}) {
+    fragile.emplace_back(v);
+  }
+  MyList<Fragile> kept {};
+  kept.push_back(0);
+  EXPECT_THROW(kept.insert(kept.begin(), fragile.begin(), fragile.end()), std::runtime_error);
+  EXPECT_EQ(kept.size(), 1);
+  EXPECT_EQ(kept.front().value, 0);
+  EXPECT_THROW((MyList<Fragile> {fragile.begin(), fragile.end()}), std::runtime_error);
+}
+
+TEST(UnrolledList, rangeBasedFor) {
+  UnrolledList<int, 4> li {};
+  const int N = 100;
+  for (int i = 0; i < N; ++i) {
+    li.push_back(i);
+  }
+  EXPECT_EQ(li.nodeCount(), N / 4);
+  int i = 0;
+  for (int x : li) {
+    EXPECT_EQ(x, i);
+    ++i;
+  }
+  EXPECT_EQ(i, N);
+}
+
+TEST(UnrolledList, reverseIteration) {
+  UnrolledList<MyInteger, 4> li {};
+  const int N = 37;
+  for (int j = 0; j < N; ++j) {
+    li.push_back(MyInteger {j});
+  }
+  int i = N;
+  for (auto it = li.end(); it != li.begin();) {
+    --it;
+    --i;
+    EXPECT_EQ(*it, MyInteger {i});
+  }
+  EXPECT_EQ(i, 0);
+}
+
+TEST(UnrolledList, insertString) {
+  UnrolledList<std::string, 2> li {"Hello", "How", "You", "Doing?"};
+  auto it = li.begin();
+  ++it;
+  ++it;
+  it = li.insert(it, "Are");
+  EXPECT_EQ(*it, "Are");
+  std::vector<std::string> phrase {"Hello", "How", "Are", "You", "Doing?"};
+  std::size_t i = 0;
+  for (const auto& x : li) {
+    EXPECT_EQ(x, phrase.at(i));
+    ++i;
+  }
+  EXPECT_EQ(li.size(), 5);
+}
+
+TEST(UnrolledList, insertOwnElement) {
+  auto contents = [](UnrolledList<std::string, 4>& li) {
+    std::vector<std::string> out {};
+    for (const auto& x : li) {
+      out.push_back(x);
+    }
+    return out;
+  };
+  // room in the node: the value is among the items shifted up
+  UnrolledList<std::string, 4> third {"a", "b", "c"};
+  auto it = third.begin();
+  ++it;
+  ++it;
+  third.insert(third.begin(), *it);
+  EXPECT_EQ(contents(third), (std::vector<std::string> {"c", "a", "b", "c"}));
+  UnrolledList<std::string, 4> second {"a", "b", "c"};
+  it = second.begin();
+  ++it;
+  second.insert(second.begin(), *it);
+  EXPECT_EQ(contents(second), (std::vector<std::string> {"b", "a", "b", "c"}));
+  // full node: the value is in the half the split moves out
+  UnrolledList<std::string, 4> split {"a", "b", "c", "d"};
+  it = split.begin();
+  ++it;
+  auto fourth = it;
+  ++fourth;
+  ++fourth;
+  split.insert(it, *fourth);
+  EXPECT_EQ(contents(split), (std::vector<std::string> {"a", "d", "b", "c", "d"}));
+}
+
+TEST(UnrolledList, randomInsertEraseMatchesStdList) {
+  std::mt19937 mt {42};
+  UnrolledList<int, 4> li {};
+  std::list<int> expected {};
+  for (int step = 0; step < 5000; ++step) {
+    int pos = expected.empty() ? 0 : static_cast<int>(mt() % (expected.size() + 1));
+    auto it = li.begin();
+    auto ex = expected.begin();
+    for (int i = 0; i < pos; ++i) {
+      ++it;
+      ++ex;
+    }
+    if (mt() % 3 != 0 || ex == expected.end()) {
+      li.insert(it, step);
+      expected.insert(ex, step);
+    }
+    else {
+      it = li.erase(it);
+      ex = expected.erase(ex);
+      EXPECT_EQ(it == li.end(), ex == expected.end());
+      if (ex != expected.end()) {
+        EXPECT_EQ(*it, *ex);
+      }
+    }
+  }
+  ASSERT_EQ(li.size(), static_cast<int>(expected.size()));
+  auto ex = expected.begin();
+  for (int x : li) {
+    EXPECT_EQ(x, *ex++);
+  }
+  EXPECT_GE(li.nodeCount() * 4, li.size());
+}
+
+TEST(UnrolledList, pushPopBothEnds) {
+  UnrolledList<std::string, 3> li {};
+  for (int i = 0; i < 10; ++i) {
+    li.push_front(std::to_string(-i));
+    li.push_back(std::to_string(i));
+  }
+  EXPECT_EQ(li.front(), "-9");
+  EXPECT_EQ(li.back(), "9");
+  for (int i = 0; i < 9; ++i) {
+    li.pop_front();
+    li.pop_back();
+  }
+  EXPECT_EQ(li.size(), 2);
+  EXPECT_EQ(li.front(), "0");
+  EXPECT_EQ(li.back(), "0");
+  UnrolledList<std::string, 3> copy {li};
+  li.clear();
+  EXPECT_TRUE(li.empty());
+  EXPECT_EQ(copy.size(), 2);
+}
+
+TEST(IndexedList, iterateBothWays) {
+  IndexedList<int> li {5, 7, 9};
+  auto it = li.begin();
+  EXPECT_EQ(*it, 5);
+  ++it;
+  EXPECT_EQ(*it, 7);
+  ++it;
+  EXPECT_EQ(*it, 9);
+  ++it;
+  EXPECT_EQ(it, li.end());
+  --it;
+  EXPECT_EQ(*it, li.back());
+  EXPECT_EQ(sizeof(IndexedList<int>::Slot), 12u);
+}
+
+TEST(IndexedList, freeSlotsAreReused) {
+  IndexedList<std::string> li {};
+  for (int i = 0; i < 10; ++i) {
+    li.push_back(std::to_string(i));
+  }
+  std::size_t slots = li.slots().size();
+  for (int i = 0; i < 5; ++i) {
+    li.pop_front();
+  }
+  for (int i = 10; i < 15; ++i) {
+    li.push_back(std::to_string(i));
+  }
+  EXPECT_EQ(li.slots().size(), slots);
+  int i = 5;
+  for (const auto& x : li) {
+    EXPECT_EQ(x, std::to_string(i++));
+  }
+  EXPECT_EQ(i, 15);
+}
+
+TEST(IndexedList, iteratorsSurviveGrowth) {
+  IndexedList<MyInteger> li {MyInteger {0}, MyInteger {1}, MyInteger {2}};
+  auto it = li.begin();
+  ++it;
+  for (int i = 0; i < 1000; ++i) {
+    li.insert(it, MyInteger {-1});
+  }
+  EXPECT_EQ(*it, MyInteger {1});
+  auto first = li.begin();
+  ++first;
+  li.erase(first);
+  EXPECT_EQ(li.size(), 1002);
+  EXPECT_EQ(li.front(), MyInteger {0});
+  EXPECT_EQ(li.back(), MyInteger {2});
+}
+
+TEST(IndexedList, elementsLiveOnlyInLinkedSlots) {
+  auto shared = std::make_shared<int>(0);
+  {
+    IndexedList<std::shared_ptr<int>> li {};
+    for (int i = 0; i < 100; ++i) {
+      li.push_back(shared);
+    }
+    for (int i = 0; i < 50; ++i) {
+      li.pop_front();
+    }
+    EXPECT_EQ(shared.use_count(), 51);
+    IndexedList<std::shared_ptr<int>> copy {li};
+    EXPECT_EQ(shared.use_count(), 101);
+    IndexedList<std::shared_ptr<int>> moved {std::move(copy)};
+    EXPECT_TRUE(copy.empty());
+    copy.push_back(shared);
+    li.clear();
+    EXPECT_EQ(shared.use_count(), 52);
+  }
+  EXPECT_EQ(shared.use_count(), 1);
+  // elements are moved across when the slots grow, even from the list itself
+  IndexedList<std::string> strings {std::string(40, 'x')};
+  for (int i = 0; i < 100; ++i) {
+    strings.push_back(strings.back());
+  }
+  for (const auto& x : strings) {
+    EXPECT_EQ(x, std::string(40, 'x'));
+  }
+  struct NoDefault {
+    explicit NoDefault(int v) : value {v} {}
+    int value;
+  };
+  IndexedList<NoDefault> nd {};
+  nd.emplace_back(3);
+  EXPECT_EQ(nd.front().value, 3);
+}
+
+TEST(IndexedList, copyIsRelocatable) {
+  IndexedList<int> li {};
+  for (int i = 0; i < 100; ++i) {
+    li.push_front(i);
+  }
+  li.erase(li.begin());
+  IndexedList<int> copy {li};
+  li.clear();
+  EXPECT_TRUE(li.empty());
+  int i = 98;
+  for (int x : copy) {
+    EXPECT_EQ(x, i--);
+  }
+  EXPECT_EQ(i, -1);
+  copy.emplace_back(-1);
+  EXPECT_EQ(copy.back(), -1);
+}
+
+TEST(RankedList, atAndIndexOf) {
+  RankedList<int> li {};
+  const int N = 1000;
+  for (int i = 0; i < N; ++i) {
+    li.push_back(i);
+  }
+  for (int k = 0; k < N; k += 37) {
+    EXPECT_EQ(li.at(k), k);
+  }
+  auto it = li.advance(li.begin(), N / 2);
+  EXPECT_EQ(*it, N / 2);
+  EXPECT_EQ(li.index_of(it), N / 2);
+  EXPECT_EQ(*li.advance(it, -10), N / 2 - 10);
+  EXPECT_EQ(li.advance(it, N / 2), li.end());
+  EXPECT_EQ(li.index_of(li.end()), N);
+  EXPECT_THROW(li.at(N), std::out_of_range);
+}
+
+TEST(RankedList, randomInsertEraseMatchesVector) {
+  std::mt19937 mt {3};
+  RankedList<int> li {};
+  std::vector<int> expected {};
+  for (int step = 0; step < 4000; ++step) {
+    int k = static_cast<int>(mt() % (expected.size() + 1));
+    if (mt() % 3 != 0 || expected.empty()) {
+      auto it = li.insert(li.advance(li.begin(), k), step);
+      expected.insert(expected.begin() + k, step);
+      EXPECT_EQ(li.index_of(it), k);
+    }
+    else {
+      k = static_cast<int>(mt() % expected.size());
+      li.erase(li.advance(li.begin(), k));
+      expected.erase(expected.begin() + k);
+    }
+  }
+  ASSERT_EQ(li.size(), static_cast<int>(expected.size()));
+  int k = 0;
+  for (auto it = li.begin(); it != li.end(); ++it, ++k) {
+    EXPECT_EQ(*it, expected[k]);
+    EXPECT_EQ(li.at(k), expected[k]);
+    EXPECT_EQ(li.index_of(it), k);
+  }
+}
+
+TEST(RankedList, noIteratorInvalidation) {
+  RankedList<MyInteger> li {MyInteger {0}, MyInteger {1}, MyInteger {2}};
+  auto it_begin = li.begin();
+  auto it_last = --li.end();
+  li.insert(it_begin, MyInteger {-1});
+  EXPECT_EQ(*it_begin, MyInteger {0});
+  EXPECT_EQ(li.index_of(it_begin), 1);
+  li.erase(li.advance(it_begin, 1));
+  EXPECT_EQ(*it_last, MyInteger {2});
+  EXPECT_EQ(li.index_of(it_last), 2);
+  RankedList<MyInteger> moved {std::move(li)};
+  EXPECT_EQ(moved.index_of(it_last), 2);
+  RankedList<MyInteger> copy {};
+  copy = moved;
+  EXPECT_EQ(copy.at(2), MyInteger {2});
+}
+
+TEST(LruCache, hitMissAndEvictionOrder) {
+  LruCache<int, std::string> cache {3};
+  cache.put(1, "one");
+  cache.put(2, "two");
+  cache.put(3, "three");
+  ASSERT_NE(cache.get(1), nullptr);
+  EXPECT_EQ(*cache.get(1), "one");
+  // 2 is now the least recent
+  cache.put(4, "four");
+  EXPECT_EQ(cache.size(), 3);
+  EXPECT_EQ(cache.get(2), nullptr);
+  EXPECT_TRUE(cache.contains(1));
+  EXPECT_TRUE(cache.contains(3));
+  EXPECT_TRUE(cache.contains(4));
+  cache.put(3, "THREE");
+  cache.put(5, "five");
+  EXPECT_FALSE(cache.contains(1));
+  EXPECT_EQ(*cache.get(3), "THREE");
+  EXPECT_TRUE(cache.erase(4));
+  EXPECT_FALSE(cache.erase(4));
+  EXPECT_EQ(cache.size(), 2);
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_EQ(cache.get(3), nullptr);
+}
+
+TEST(LruCache, evictionReusesNode) {
+  LruCache<int, MyInteger> cache {2};
+  cache.put(1, MyInteger {1});
+  cache.put(2, MyInteger {2});
+  MyInteger* cold = cache.get(1);
+  cache.get(2);
+  cache.put(3, MyInteger {3});
+  // the node that held 1 now holds 3
+  EXPECT_EQ(cache.get(3), cold);
+  EXPECT_EQ(*cold, MyInteger {3});
+  EXPECT_EQ(cache.get(1), nullptr);
+  // moving keeps the nodes, and so the index into them; copying is refused
+  static_assert(!std::is_copy_constructible_v<LruCache<int, MyInteger>>);
+  LruCache<int, MyInteger> moved {std::move(cache)};
+  EXPECT_EQ(moved.get(3), cold);
+  EXPECT_EQ(*moved.get(2), MyInteger {2});
+}
+
+TEST(LruCache, usableAfterMove) {
+  LruCache<int, std::string> cache {10, [](const int&, const std::string& value) { return value.size(); }};
+  cache.put(1, "abcd");
+  LruCache<int, std::string> moved {std::move(cache)};
+  // the moved-from cache is empty, keeps its capacity and counts entries
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_EQ(cache.get(1), nullptr);
+  cache.put(2, "abcdef");
+  EXPECT_EQ(*cache.get(2), "abcdef");
+  EXPECT_EQ(cache.weight(), 1u);
+  LruCache<int, std::string> other {3};
+  other.put(3, "x");
+  other = std::move(moved);
+  EXPECT_EQ(*other.get(1), "abcd");
+  EXPECT_EQ(other.weight(), 4u);
+  EXPECT_EQ(moved.size(), 0);
+  EXPECT_FALSE(moved.contains(3));
+  moved.put(4, "y");
+  EXPECT_TRUE(moved.contains(4));
+}
+
+TEST(LruCache, byteCapacity) {
+  LruCache<int, std::string> cache {10, [](const int&, const std::string& value) { return value.size(); }};
+  cache.put(1, "aaaa");
+  cache.put(2, "bbbb");
+  EXPECT_EQ(cache.weight(), 8u);
+  // needs both older entries gone
+  cache.put(3, "cccccccc");
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_EQ(cache.weight(), 8u);
+  cache.put(4, "dd");
+  EXPECT_EQ(cache.weight(), 10u);
+  // growing an entry in place evicts others
+  cache.put(4, "dddd");
+  EXPECT_FALSE(cache.contains(3));
+  EXPECT_EQ(cache.weight(), 4u);
+  // too heavy to cache at all, and the old value goes too
+  cache.put(4, "eeeeeeeeeeee");
+  EXPECT_FALSE(cache.contains(4));
+  EXPECT_EQ(cache.weight(), 0u);
+}
+
+TEST(LruCache, randomOpsMatchReference) {
+  std::mt19937 mt {9};
+  const int capacity = 200;
+  LruCache<int, int> cache {static_cast<std::size_t>(capacity)};
+  // reference: most recent first
+  std::list<std::pair<int, int>> expected {};
+  for (int step = 0; step < 20000; ++step) {
+    int key = static_cast<int>(mt() % 600);
+    auto it = std::find_if(expected.begin(), expected.end(), [&](const auto& e) { return e.first == key; });
+    switch (mt() % 3) {
+      case 0: {
+        int* value = cache.get(key);
+        ASSERT_EQ(value != nullptr, it != expected.end());
+        if (value != nullptr) {
+          EXPECT_EQ(*value, it->second);
+          expected.splice(expected.begin(), expected, it);
+        }
+        break;
+      }
+      case 1:
+        cache.put(key, step);
+        if (it != expected.end()) {
+          expected.erase(it);
+        }
+        expected.emplace_front(key, step);
+        if (static_cast<int>(expected.size()) > capacity) {
+          expected.pop_back();
+        }
+        break;
+      default:
+        EXPECT_EQ(cache.erase(key), it != expected.end());
+        if (it != expected.end()) {
+          expected.erase(it);
+        }
+    }
+  }
+  ASSERT_EQ(cache.size(), static_cast<int>(expected.size()));
+  for (const auto& e : expected) {
+    EXPECT_TRUE(cache.contains(e.first));
+  }
+}
+
+TEST(ConcurrentQueue, singleThreadFifo) {
+  ConcurrentQueue<std::string> queue {};
+  std::string out {};
+  EXPECT_TRUE(queue.empty());
+  EXPECT_FALSE(queue.pop_front(out));
+  queue.push_back("a");
+  queue.emplace_back(3, 'b');
+  EXPECT_FALSE(queue.empty());
+  ASSERT_TRUE(queue.pop_front(out));
+  EXPECT_EQ(out, "a");
+  ASSERT_TRUE(queue.pop_front(out));
+  EXPECT_EQ(out, "bbb");
+  EXPECT_FALSE(queue.pop_front(out));
+  // left behind for the destructor
+  queue.push_back("c");
+}
+
+TEST(ConcurrentQueue, producersAndConsumers) {
+  const int producers = 4;
+  const int consumers = 4;
+  const int perProducer = 20000;
+  ConcurrentQueue<std::pair<int, int>> queue {};
+  std::vector<std::vector<std::pair<int, int>>> received(consumers);
+  std::atomic<int> remaining {producers * perProducer};
+  std::vector<std::thread> threads {};
+  for (int p = 0; p < producers; ++p) {
+    threads.emplace_back([&, p] {
+      for (int i = 0; i < perProducer; ++i) {
+        queue.push_back({p, i});
+      }
+    });
+  }
+  for (int c = 0; c < consumers; ++c) {
+    threads.emplace_back([&, c] {
+      std::pair<int, int> item {};
+      while (remaining.load() > 0) {
+        if (queue.pop_front(item)) {
+          received[c].push_back(item);
+          remaining.fetch_sub(1);
+        }
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  EXPECT_TRUE(queue.empty());
+  // every item arrives exactly once, and each consumer sees every
+  // producer's items in the order they were pushed
+  std::vector<int> seen(producers * perProducer, 0);
+  for (const auto& items : received) {
+    std::vector<int> last(producers, -1);
+    for (const auto& [p, i] : items) {
+      EXPECT_GT(i, last[p]);
+      last[p] = i;
+      seen[p * perProducer + i]++;
+    }
+  }
+  EXPECT_EQ(std::count(seen.begin(), seen.end(), 1), producers * perProducer);
+}
+
+TEST(ConcurrentSet, sortedUniqueValues) {
+  ConcurrentSet<int> set {};
+  EXPECT_TRUE(set.insert(5));
+  EXPECT_TRUE(set.insert(1));
+  EXPECT_TRUE(set.insert(3));
+  EXPECT_FALSE(set.insert(3));
+  EXPECT_EQ(set.size(), 3);
+  EXPECT_TRUE(set.contains(1));
+  EXPECT_FALSE(set.contains(2));
+  EXPECT_TRUE(set.erase(1));
+  EXPECT_FALSE(set.erase(1));
+  EXPECT_FALSE(set.contains(1));
+  std::vector<int> values {};
+  set.for_each([&](int v) { values.push_back(v); });
+  EXPECT_EQ(values, (std::vector<int> {3, 5}));
+  ConcurrentSet<int, std::greater<int>> descending {};
+  descending.insert(1);
+  descending.insert(2);
+  values.clear();
+  descending.for_each([&](int v) { values.push_back(v); });
+  EXPECT_EQ(values, (std::vector<int> {2, 1}));
+}
+
+TEST(ConcurrentSet, concurrentInsertErase) {
+  const int threads = 6;
+  const int range = 300;
+  ConcurrentSet<int> set {};
+  // thread t owns the keys equal to t modulo threads, so the final
+  // contents are known; contains runs over the whole range meanwhile
+  std::vector<std::vector<bool>> present(threads, std::vector<bool>(range, false));
+  std::vector<std::thread> workers {};
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      std::mt19937 mt {static_cast<unsigned>(t)};
+      for (int step = 0; step < 20000; ++step) {
+        int key = static_cast<int>(mt() % (range / threads)) * threads + t;
+        switch (mt() % 3) {
+          case 0:
+            EXPECT_EQ(set.insert(key), !present[t][key]);
+            present[t][key] = true;
+            break;
+          case 1:
+            EXPECT_EQ(set.erase(key), present[t][key]);
+            present[t][key] = false;
+            break;
+          default:
+            EXPECT_EQ(set.contains(key), present[t][key]);
+            set.contains(static_cast<int>(mt() % range));
+        }
+      }
+    });
+  }
+  for (auto& w : workers) {
+    w.join();
+  }
+  std::vector<int> expected {};
+  for (int key = 0; key < range; ++key) {
+    if (present[key % threads][key]) {
+      expected.push_back(key);
+    }
+  }
+  std::vector<int> values {};
+  set.for_each([&](int v) { values.push_back(v); });
+  EXPECT_EQ(values, expected);
+  EXPECT_EQ(set.size(), static_cast<int>(expected.size()));
+}
+
+TEST(RcuList, writerAndReaderView) {
+  RcuList<std::string> li {};
+  li.push_back("b");
+  li.push_front("a");
+  li.push_back("d");
+  auto it = li.insert(std::next(li.begin(), 2), "c");
+  EXPECT_EQ(*it, "c");
+  EXPECT_EQ(li.size(), 4);
+  {
+    auto view = li.read();
+    std::vector<std::string> seen(view.begin(), view.end());
+    EXPECT_EQ(seen, (std::vector<std::string> {"a", "b", "c", "d"}));
+    // a view taken before an erase still walks through the erased node
+    auto held = view.begin();
+    ++held;
+    li.erase(held);
+    li.replace(li.begin(), "A");
+    EXPECT_EQ(*held, "b");
+    ++held;
+    EXPECT_EQ(*held, "c");
+  }
+  std::vector<std::string> seen {};
+  li.for_each([&](const std::string& v) { seen.push_back(v); });
+  EXPECT_EQ(seen, (std::vector<std::string> {"A", "c", "d"}));
+  li.pop_back();
+  li.pop_front();
+  EXPECT_EQ(li.size(), 1);
+  li.clear();
+  EXPECT_TRUE(li.empty());
+  EXPECT_EQ(li.read().begin(), li.read().end());
+}
+
+TEST(RcuList, readersSeeConsistentSnapshots) {
+  RcuList<int> li {};
+  for (int i = 0; i < 64; ++i) {
+    li.push_back(i * 2);
+  }
+  std::atomic<bool> done {false};
+  std::atomic<long long> walks {0};
+  // readers that have finished at least one walk
+  std::atomic<int> walked {0};
+  std::vector<std::thread> readers {};
+  for (int r = 0; r < 3; ++r) {
+    readers.emplace_back([&] {
+      bool first = true;
+      while (!done.load()) {
+        // the writer keeps the list sorted, so every walk must be too
+        int last = -1;
+        for (int v : li.read()) {
+          EXPECT_GT(v, last);
+          last = v;
+        }
+        walks.fetch_add(1);
+        if (first) {
+          walked.fetch_add(1);
+          first = false;
+        }
+      }
+    });
+  }
+  std::mt19937 mt {5};
+  for (int step = 0; step < 20000; ++step) {
+    int k = static_cast<int>(mt() % li.size());
+    auto it = std::next(li.begin(), k);
+    if (mt() % 2 == 0 && li.size() > 1) {
+      li.erase(it);
+    }
+    else {
+      // something strictly between the neighbours, if there is room
+      int before = it == li.begin() ? -1 : *std::next(li.begin(), k - 1);
+      if (*it - before > 1) {
+        li.insert(it, before + 1);
+      }
+      else {
+        li.replace(it, *it);
+      }
+    }
+  }
+  // the writer may finish before a reader is even scheduled
+  while (walked.load() < 3) {
+    std::this_thread::yield();
+  }
+  done.store(true);
+  for (auto& r : readers) {
+    r.join();
+  }
+  EXPECT_GT(walks.load(), 0);
+  int last = -1;
+  int count = 0;
+  for (int v : li.read()) {
+    EXPECT_GT(v, last);
+    last = v;
+    ++count;
+  }
+  EXPECT_EQ(count, li.size());
+}
+
+TEST(LockCouplingList, noIteratorInvalidation) {
+  LockCouplingList<MyInteger> li {};
+  li.push_back(MyInteger {1});
+  li.push_back(MyInteger {2});
+  li.push_front(MyInteger {0});
+  auto it_begin = li.begin();
+  auto it_last = --li.end();
+  li.insert(it_begin, MyInteger {-1});
+  EXPECT_EQ(*it_begin, MyInteger {0});
+  li.erase(std::next(it_begin));
+  EXPECT_EQ(*it_last, MyInteger {2});
+  EXPECT_EQ(*std::next(it_begin), MyInteger {2});
+  EXPECT_EQ(li.size(), 3);
+  auto found = li.find_if([](const MyInteger& v) { return v == MyInteger {2}; });
+  EXPECT_EQ(found, it_last);
+  EXPECT_EQ(li.find_if([](const MyInteger& v) { return v == MyInteger {7}; }), li.end());
+  int count = 0;
+  li.for_each([&](MyInteger&) { ++count; });
+  EXPECT_EQ(count, 3);
+  li.erase(li.begin());
+  li.erase(li.begin());
+  li.erase(li.begin());
+  EXPECT_TRUE(li.empty());
+  EXPECT_EQ(li.begin(), li.end());
+}
+
+TEST(LockCouplingList, threadsOnDisjointRegions) {
+  const int threads = 4;
+  LockCouplingList<int> li {};
+  // one anchor per thread; each thread grows and shrinks the stretch just
+  // in front of its own anchor, and anchors are never erased
+  std::vector<LockCouplingList<int>::Iterator> anchors {};
+  for (int t = 0; t < threads; ++t) {
+    li.push_back(-1);
+    anchors.push_back(--li.end());
+  }
+  std::atomic<bool> done {false};
+  std::thread walker {[&] {
+    while (!done.load()) {
+      int anchorsSeen = 0;
+      li.for_each([&](int v) { anchorsSeen += v == -1; });
+      EXPECT_EQ(anchorsSeen, threads);
+    }
+  }};
+  std::vector<std::thread> workers {};
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      std::mt19937 mt {static_cast<unsigned>(t)};
+      int mine = 0;
+      for (int step = 0; step < 20000; ++step) {
+        if (mine == 0 || mt() % 2 == 0) {
+          li.insert(anchors[t], t);
+          ++mine;
+        }
+        else {
+          li.erase(std::prev(anchors[t]));
+          --mine;
+        }
+      }
+      while (mine-- > 0) {
+        li.erase(std::prev(anchors[t]));
+      }
+    });
+  }
+  for (auto& w : workers) {
+    w.join();
+  }
+  done.store(true);
+  walker.join();
+  EXPECT_EQ(li.size(), threads);
+}
+
+TEST(List, splitPoints) {
+  MyList<int> li {};
+  EXPECT_EQ(li.split_points(4).size(), 1u);
+  for (int i = 0; i < 1000; ++i) {
+    li.push_back(i);
+  }
+  // checkpoints kept while appending, then rebuilt after an erase
+  for (int round = 0; round < 2; ++round) {
+    auto points = li.split_points(4);
+    ASSERT_EQ(points.size(), 5u);
+    EXPECT_EQ(points.front(), li.begin());
+    EXPECT_EQ(points.back(), li.end());
+    for (std::size_t i = 0; i + 1 < points.size(); ++i) {
+      long run = std::distance(points[i], points[i + 1]);
+      EXPECT_GT(run, 200);
+      EXPECT_LT(run, 300);
+    }
+    li.pop_front();
+  }
+  // too short to be worth splitting: one run
+  MyList<int> few {1, 2};
+  EXPECT_EQ(few.split_points(8).size(), 2u);
+
+  // lists grown at the front and in the middle are rebuilt evenly too
+  MyList<int> fronts {};
+  MyList<int> middles {0, 1};
+  for (int i = 0; i < 100000; ++i) {
+    fronts.push_front(i);
+    middles.emplace(std::next(middles.begin()), i);
+  }
+  middles.emplace(middles.end(), -1);
+  for (MyList<int>* grown : {&fronts, &middles}) {
+    auto points = grown->split_points(8);
+    ASSERT_EQ(points.size(), 9u);
+    for (std::size_t i = 0; i + 1 < points.size(); ++i) {
+      long run = std::distance(points[i], points[i + 1]);
+      EXPECT_GT(run, 10000);
+      EXPECT_LT(run, 15000);
+    }
+  }
+}
+
+TEST(ParallelList, forEachAndReduce) {
+  ThreadPool pool {3};
+  MyList<long long> li {};
+  EXPECT_EQ(parallel_reduce(pool, li, 7LL, std::plus<>()), 7);
+  for (long long i = 1; i <= 10000; ++i) {
+    li.push_back(i);
+  }
+  parallel_for_each(pool, li, [](long long& v) { v *= 2; });
+  EXPECT_EQ(parallel_reduce(pool, li, 0LL, std::plus<>()), 10000LL * 10001);
+  EXPECT_EQ(parallel_reduce(pool, li, 0LL, std::plus<>(), [](long long v) { return v % 3 == 0; }), 3333);
+  // runs are folded in list order, so a non-commutative reduce works
+  MyList<std::string> words {"a", "b", "c", "d", "e", "f", "g"};
+  EXPECT_EQ(parallel_reduce(pool, words, std::string {">"}, std::plus<>()), ">abcdefg");
+  EXPECT_THROW(pool.run(4, [](int i) { if (i == 2) throw std::runtime_error {"task"}; }), std::runtime_error);
+}
+
+TEST(PersistentList, versionsShareTails) {
+  PersistentList<std::string> base {"b", "c"};
+  PersistentList<std::string> a = base.push_front("a");
+  PersistentList<std::string> x = base.push_front("x");
+  PersistentList<std::string> snapshot = a;
+  EXPECT_TRUE(snapshot.shares(a));
+  EXPECT_EQ(std::vector<std::string>(a.begin(), a.end()), (std::vector<std::string> {"a", "b", "c"}));
+  EXPECT_EQ(std::vector<std::string>(x.begin(), x.end()), (std::vector<std::string> {"x", "b", "c"}));
+  EXPECT_EQ(std::vector<std::string>(base.begin(), base.end()), (std::vector<std::string> {"b", "c"}));
+  EXPECT_TRUE(a.pop_front().shares(base));
+  EXPECT_EQ(&*std::next(a.begin()), &*std::next(x.begin()));
+  EXPECT_EQ(a.size(), 3);
+  // dropping versions frees only the nodes no other version holds
+  base = PersistentList<std::string> {};
+  a = a.pop_front().pop_front().pop_front().pop_front();
+  EXPECT_TRUE(a.empty());
+  EXPECT_EQ(std::vector<std::string>(x.begin(), x.end()), (std::vector<std::string> {"x", "b", "c"}));
+  EXPECT_EQ(snapshot.front(), "a");
+  MyList<int> li {1, 2, 3};
+  PersistentList<int> copied(li.begin(), li.end());
+  EXPECT_EQ(std::vector<int>(copied.begin(), copied.end()), (std::vector<int> {1, 2, 3}));
+  // a long unshared chain is freed without recursing
+  PersistentList<int> deep {};
+  for (int i = 0; i < 1000000; ++i) {
+    deep = deep.push_front(i);
+  }
+}
+
+TEST(PersistentList, snapshotsAcrossThreads) {
+  PersistentList<int> current {};
+  std::mutex lock {};
+  std::atomic<bool> done {false};
+  std::vector<std::thread> readers {};
+  for (int t = 0; t < 3; ++t) {
+    readers.emplace_back([&] {
+      while (!done.load()) {
+        PersistentList<int> snapshot {};
+        {
+          std::lock_guard<std::mutex> guard {lock};
+          snapshot = current;
+        }
+        // each version counts down from its front to 0
+        int expected = snapshot.empty() ? 0 : snapshot.front();
+        for (int v : snapshot) {
+          EXPECT_EQ(v, expected--);
+        }
+      }
+    });
+  }
+  for (int i = 0; i < 20000; ++i) {
+    std::lock_guard<std::mutex> guard {lock};
+    current = i % 3 == 2 ? current.pop_front() : current.push_front(current.size());
+  }
+  done.store(true);
+  for (auto& r : readers) {
+    r.join();
+  }
+}
+
+TEST(OrderedList, beforeMatchesPositions) {
+  OrderedList<int> li {};
+  std::vector<OrderedList<int>::Iterator> its {};
+  std::mt19937 mt {21};
+  // inserts mostly in one spot, to force group splits and relabelling
+  for (int i = 0; i < 5000; ++i) {
+    OrderedList<int>::Iterator at = li.end();
+    if (!its.empty()) {
+      at = mt() % 4 == 0 ? its[mt() % its.size()] : its[its.size() / 2];
+    }
+    its.push_back(li.insert(at, i));
+    if (mt() % 5 == 0) {
+      std::size_t k = mt() % its.size();
+      li.erase(its[k]);
+      its.erase(its.begin() + static_cast<long>(k));
+    }
+  }
+  std::vector<OrderedList<int>::Iterator> inOrder {};
+  for (auto it = li.begin(); it != li.end(); ++it) {
+    inOrder.push_back(it);
+  }
+  ASSERT_EQ(inOrder.size(), its.size());
+  for (int probe = 0; probe < 20000; ++probe) {
+    std::size_t a = mt() % inOrder.size();
+    std::size_t b = mt() % inOrder.size();
+    EXPECT_EQ(li.before(inOrder[a], inOrder[b]), a < b);
+  }
+  EXPECT_TRUE(li.before(li.begin(), li.end()));
+  EXPECT_FALSE(li.before(li.end(), li.begin()));
+}
+
+TEST(OrderedList, frontAndBack) {
+  OrderedList<std::string> li {"m"};
+  for (int i = 0; i < 200; ++i) {
+    li.push_front("f");
+    li.push_back("b");
+  }
+  EXPECT_TRUE(li.before(li.begin(), std::prev(li.end())));
+  EXPECT_FALSE(li.before(std::prev(li.end()), li.begin()));
+  auto m = std::next(li.begin(), 200);
+  EXPECT_EQ(*m, "m");
+  EXPECT_TRUE(li.before(std::prev(m), m));
+  EXPECT_TRUE(li.before(m, std::next(m)));
+  OrderedList<std::string> copy = li;
+  while (!li.empty()) {
+    li.pop_back();
+  }
+  EXPECT_EQ(copy.size(), 401);
+  EXPECT_TRUE(copy.before(copy.begin(), std::next(copy.begin())));
+}
+
+TEST(OrderedList, relabelsGroups) {
+  // Each insert goes in front of the previous one, so new groups keep
+  // landing in the same spot and use up the group labels there.  The list
+  // then holds n - 1 down to 0, each element before the next.
+  auto descending = [](auto& li) {
+    int expected = li.size() - 1;
+    auto prev = li.end();
+    for (auto it = li.begin(); it != li.end(); prev = it++) {
+      if (*it != expected-- || (prev != li.end() && !li.before(prev, it))) {
+        return false;
+      }
+    }
+    return expected == -1;
+  };
+  OrderedList<int> li {};
+  auto at = li.end();
+  for (int i = 0; i < 2000000; ++i) {
+    at = li.insert(at, i);
+  }
+  EXPECT_TRUE(descending(li));
+  // 16-bit group labels run out after about a hundred groups
+  OrderedList<int, 16> narrow {};
+  auto spot = narrow.end();
+  int inserted = 0;
+  auto fill = [&] {
+    for (;;) {
+      spot = narrow.insert(spot, inserted);
+      ++inserted;
+    }
+  };
+  EXPECT_THROW(fill(), std::length_error);
+  EXPECT_EQ(narrow.size(), inserted);
+  EXPECT_TRUE(descending(narrow));
+  narrow.push_back(-1);
+  EXPECT_TRUE(narrow.before(spot, std::prev(narrow.end())));
+}
+
+TEST(ParallelList, sorts) {
+  ThreadPool pool {3};
+  std::mt19937 mt {5};
+  std::vector<int> values(20000);
+  for (auto& v : values) {
+    v = static_cast<int>(mt() % 2000) - 1000;
+  }
+  std::vector<int> expected = values;
+  std::sort(expected.begin(), expected.end());
+
+  MyList<int> li(values.begin(), values.end());
+  parallel_sort(pool, li);
+  EXPECT_EQ(std::vector<int>(li.begin(), li.end()), expected);
+  EXPECT_EQ(*std::prev(li.end()), expected.back());
+  MyList<int> radix(values.begin(), values.end());
+  radix.radix_sort();
+  EXPECT_EQ(std::vector<int>(radix.begin(), radix.end()), expected);
+
+  // both are stable: sort pairs on the first member only
+  std::vector<std::pair<int, int>> pairs {};
+  for (int i = 0; i < 5000; ++i) {
+    pairs.emplace_back(static_cast<int>(mt() % 50), i);
+  }
+  std::vector<std::pair<int, int>> stable = pairs;
+  std::stable_sort(stable.begin(), stable.end(), [](auto& a, auto& b) { return a.first < b.first; });
+  MyList<std::pair<int, int>> byKey(pairs.begin(), pairs.end());
+  parallel_sort(pool, byKey, [](auto& a, auto& b) { return a.first < b.first; });
+  EXPECT_EQ((std::vector<std::pair<int, int>>(byKey.begin(), byKey.end())), stable);
+  MyList<std::pair<int, int>> byRadix(pairs.begin(), pairs.end());
+  byRadix.radix_sort([](const std::pair<int, int>& p) { return static_cast<unsigned char>(p.first); });
+  EXPECT_EQ((std::vector<std::pair<int, int>>(byRadix.begin(), byRadix.end())), stable);
+}
+
+TEST(List, bulkRemoval) {
+  MyList<int> li {3, 1, 1, 4, 1, 5, 9, 2, 6, 5, 5};
+  auto second = std::next(li.begin());
+  auto nine = std::find(li.begin(), li.end(), 9);
+  EXPECT_EQ(li.remove_if([](int v) { return v % 2 == 0; }), 3);
+  EXPECT_EQ(std::vector<int>(li.begin(), li.end()), (std::vector<int> {3, 1, 1, 1, 5, 9, 5, 5}));
+  EXPECT_EQ(*second, 1);
+  EXPECT_EQ(li.unique(), 3);
+  EXPECT_EQ(std::vector<int>(li.begin(), li.end()), (std::vector<int> {3, 1, 5, 9, 5}));
+  EXPECT_EQ(*nine, 9);
+  // the value may be an element that is itself removed
+  EXPECT_EQ(li.remove(li.back()), 2);
+  EXPECT_EQ(std::vector<int>(li.begin(), li.end()), (std::vector<int> {3, 1, 9}));
+  EXPECT_EQ(li.erase(std::next(li.begin()), li.end()), li.end());
+  EXPECT_EQ(li.size(), 1);
+  EXPECT_EQ(li.back(), 3);
+  EXPECT_EQ(li.unique([](int a, int b) { return a > b; }), 0);
+  li.push_back(1);
+  li.push_back(2);
+  // 2 is compared with 3, not with the removed 1
+  EXPECT_EQ(li.unique([](int a, int b) { return a > b; }), 2);
+  EXPECT_EQ(li.size(), 1);
+
+  // a throwing pred keeps what it has not looked at yet
+  MyList<int> partial {1, 2, 3, 4, 5, 6};
+  EXPECT_THROW(partial.remove_if([](int v) {
+    if (v == 5) {
+      throw std::runtime_error("pred");
+    }
+    return v % 2 == 1;
+  }),
+               std::runtime_error);
+  EXPECT_EQ(std::vector<int>(partial.begin(), partial.end()), (std::vector<int> {2, 4, 5, 6}));
+  EXPECT_EQ(*std::prev(partial.end()), 6);
+  EXPECT_EQ(*std::prev(std::prev(partial.end(), 3)), 2);
+
+  // inline and pool nodes removed together
+  MyList<std::string, 4> mixed {};
+  for (int i = 0; i < 10; ++i) {
+    mixed.push_back(std::to_string(i));
+  }
+  EXPECT_EQ(mixed.remove_if([](const std::string& s) { return s[0] < '6'; }), 6);
+  EXPECT_EQ(std::vector<std::string>(mixed.begin(), mixed.end()), (std::vector<std::string> {"6", "7", "8", "9"}));
+  for (int i = 0; i < 6; ++i) {
+    mixed.push_front("x");
+  }
+  EXPECT_EQ(mixed.remove("x"), 6);
+  EXPECT_EQ(mixed.size(), 4);
+
+  // split nodes give back their payload slots as well
+  MyList<Document> docs {};
+  for (int i = 0; i < 50; ++i) {
+    docs.emplace_back(std::string(30, 'd'), i);
+  }
+  EXPECT_EQ(docs.remove_if([](const Document& d) { return d.key % 5 != 0; }), 40);
+  auto sixth = std::next(docs.begin(), 5);
+  EXPECT_EQ(docs.erase(docs.begin(), sixth), sixth);
+  EXPECT_EQ(docs.begin(), sixth);
+  EXPECT_EQ(docs.front().key, 25);
+  for (int i = 0; i < 45; ++i) {
+    docs.emplace_back("again", 100 + i);
+  }
+  EXPECT_EQ(docs.size(), 50);
+  EXPECT_EQ(docs.back().text, "again");
+}
+
+// MappedList is POSIX only for now
+#ifndef _WIN32
+struct Sample {
+  int id;
+  double value;
+};
+
+TEST(MappedList, reopenAndRecover) {
+  auto path = (std::filesystem::temp_directory_path() / "mappedListTest.bin").string();
+  auto crashed = path + ".crashed";
+  std::filesystem::remove(path);
+  std::filesystem::remove(crashed);
+  {
+    MappedList<Sample> li(path);
+    EXPECT_TRUE(li.empty());
+    li.push_back({0, 0.0});
+    auto first = li.begin();
+    // enough to grow the file, and map it again, a few times
+    for (int i = 1; i < 5000; ++i) {
+      li.emplace_back(Sample {i, i * 0.5});
+    }
+    EXPECT_EQ(first->id, 0);
+    li.flush();
+    for (int i = 0; i < 100; ++i) {
+      li.push_back({-1, 0.0});
+    }
+    // what the disk may hold if the process died here
+    std::filesystem::copy_file(path, crashed);
+  }
+  {
+    MappedList<Sample> li(path);
+    EXPECT_EQ(li.size(), 5100);
+    EXPECT_EQ(li.back().id, -1);
+  }
+  {
+    MappedList<Sample> li(crashed);
+    ASSERT_EQ(li.size(), 5000);
+    EXPECT_EQ(std::distance(li.begin(), li.end()), 5000);
+    EXPECT_EQ(std::prev(li.end())->id, 4999);
+    int expected = 0;
+    for (const Sample& s : li) {
+      EXPECT_EQ(s.id, expected);
+      EXPECT_EQ(s.value, expected * 0.5);
+      ++expected;
+    }
+    li.push_back({5000, 2500.0});
+    EXPECT_EQ(li.back().id, 5000);
+    li.clear();
+  }
+  {
+    MappedList<Sample> li(crashed);
+    EXPECT_TRUE(li.empty());
+    EXPECT_EQ(li.begin(), li.end());
+  }
+  // a file of another element type is refused
+  EXPECT_THROW(MappedList<char> {path}, std::runtime_error);
+  std::filesystem::remove(path);
+  std::filesystem::remove(crashed);
+
+  // an element of the list itself, pushed across every growth of the file
+  {
+    MappedList<Sample> li(path);
+    li.push_back({7, 3.5});
+    for (int i = 0; i < 10000; ++i) {
+      li.push_back(li.back());
+    }
+    EXPECT_EQ(li.size(), 10001);
+    for (const Sample& s : li) {
+      EXPECT_EQ(s.id, 7);
+      EXPECT_EQ(s.value, 3.5);
+    }
+  }
+  // a header whose links lead outside the nodes is refused before use
+  auto damage = [&](std::streamoff field, std::uint64_t value) {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(field * static_cast<std::streamoff>(sizeof(value)));
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+  // a tail past the end, one between two nodes, and none at all
+  damage(4, std::uint64_t {1} << 40);
+  EXPECT_THROW(MappedList<Sample> {path}, std::runtime_error);
+  damage(4, 64);
+  EXPECT_THROW(MappedList<Sample> {path}, std::runtime_error);
+  damage(4, 0);
+  EXPECT_THROW(MappedList<Sample> {path}, std::runtime_error);
+  std::filesystem::remove(path);
+}
+#endif
+
+TEST(ListStream, roundTrip) {
+  // several chunks of ints, and strings with an empty one among them
+  std::vector<int> ints(100000);
+  std::iota(ints.begin(), ints.end(), -50000);
+  MyList<int> numbers(ints.begin(), ints.end());
+  std::stringstream buffer {};
+  write(buffer, numbers);
+  MyList<int> numbersBack {7};
+  ListReader<int> numberReader(buffer, numbersBack);
+  EXPECT_EQ(numberReader.loaded(), 1);
+  numberReader.read_all();
+  EXPECT_TRUE(numberReader.done());
+  EXPECT_EQ(numbersBack.size(), 100001);
+  EXPECT_EQ(numbersBack.front(), 7);
+  numbersBack.pop_front();
+  EXPECT_EQ(std::vector<int>(numbersBack.begin(), numbersBack.end()), ints);
+
+  MyList<std::string> words {};
+  for (int i = 0; i < 20000; ++i) {
+    words.push_back(std::string(static_cast<std::size_t>(i % 37), static_cast<char>('a' + i % 26)));
+  }
+  std::stringstream wordBuffer {};
+  write(wordBuffer, words);
+  MyList<std::string> wordsBack {};
+  ListReader<std::string> wordReader(wordBuffer, wordsBack);
+  EXPECT_TRUE(wordReader.read_chunk());
+  EXPECT_GT(wordReader.loaded(), 0);
+  EXPECT_LT(wordReader.loaded(), 20000);
+  wordReader.read_all();
+  EXPECT_TRUE(std::equal(words.begin(), words.end(), wordsBack.begin(), wordsBack.end()));
+
+  // a stream of another element type, and one cut short
+  std::stringstream wrongType(buffer.str());
+  MyList<std::string> unused {};
+  EXPECT_THROW((ListReader<std::string>(wrongType, unused)), std::runtime_error);
+  std::string bytes = buffer.str();
+  std::stringstream cut(bytes.substr(0, bytes.size() / 2));
+  MyList<int> partial {};
+  ListReader<int> cutReader(cut, partial);
+  EXPECT_THROW(cutReader.read_all(), std::runtime_error);
+  EXPECT_TRUE(cutReader.done());
+  EXPECT_EQ(partial.size(), cutReader.loaded());
+  EXPECT_GT(partial.size(), 0);
+
+  // an element just under the chunk limit after a small one gets a chunk
+  // of its own; one over it is refused by the writer, not the reader
+  std::size_t limit = ListFormat<std::string>::maxChunkBytes;
+  MyList<std::string> large {"small", std::string(limit - 4, 'l')};
+  std::stringstream largeBuffer {};
+  write(largeBuffer, large);
+  MyList<std::string> largeBack {};
+  ListReader<std::string>(largeBuffer, largeBack).read_all();
+  EXPECT_EQ(largeBack.size(), 2);
+  EXPECT_EQ(largeBack.back().size(), limit - 4);
+  large.push_back(std::string(limit, 'x'));
+  std::stringstream tooLarge {};
+  EXPECT_THROW(write(tooLarge, large), std::length_error);
+}
+
+TEST(ListStream, consumeWhileLoading) {
+  MyList<long long> source {};
+  for (long long i = 0; i < 200000; ++i) {
+    source.push_back(i * 3);
+  }
+  std::stringstream buffer {};
+  write(buffer, source);
+  MyList<long long> li {};
+  ListReader<long long> reader(buffer, li);
+  std::thread loader([&] { reader.read_all(); });
+  long long sum = 0;
+  int seen = 0;
+  MyList<long long>::Iterator it {};
+  for (int available = reader.wait_for(1); available > seen; available = reader.wait_for(seen + 1)) {
+    for (; seen < available; ++seen) {
+      it = seen == 0 ? li.begin() : std::next(it);
+      sum += *it;
+    }
+  }
+  loader.join();
+  EXPECT_EQ(seen, 200000);
+  EXPECT_EQ(sum, source.accumulate(0LL));
+}
+
+struct Session {
+  int id {};
+  ListHook byAge {};
+  ListHook byUser {};
+  explicit Session(int i) : id {i} {}
+};
+
+TEST(IntrusiveList, iterateAndEraseByObject) {
+  std::vector<Session> table {};
+  for (int i = 0; i < 5; ++i) {
+    table.emplace_back(i);
+  }
+  MyIntrusiveList<Session, &Session::byAge> byAge {};
+  for (auto& s : table) {
+    byAge.push_back(s);
+  }
+  EXPECT_EQ(byAge.size(), 5);
+  byAge.erase(table[2]);
+  EXPECT_FALSE(table[2].byAge.isLinked());
+  std::vector<int> ids {};
+  for (const auto& s : byAge) {
+    ids.push_back(s.id);
+  }
+  EXPECT_EQ(ids, (std::vector<int> {0, 1, 3, 4}));
+  auto it = byAge.end();
+  --it;
+  EXPECT_EQ(it->id, 4);
+  EXPECT_EQ(&byAge.front(), &table[0]);
+  byAge.clear();
+  EXPECT_TRUE(byAge.empty());
+  EXPECT_FALSE(table[0].byAge.isLinked());
+}
+
+TEST(IntrusiveList, objectOnTwoLists) {
+  std::vector<Session> table {};
+  for (int i = 0; i < 4; ++i) {
+    table.emplace_back(i);
+  }
+  MyIntrusiveList<Session, &Session::byAge> byAge {};
+  MyIntrusiveList<Session, &Session::byUser> byUser {};
+  for (auto& s : table) {
+    byAge.push_back(s);
+    byUser.push_front(s);
+  }
+  byUser.erase(table[1]);
+  byAge.erase(table[3]);
+  auto inserted = byAge.insert(byAge.iteratorTo(table[0]), table[3]);
+  EXPECT_EQ(inserted->id, 3);
+  EXPECT_EQ(byAge.size(), 4);
+  EXPECT_EQ(byAge.front().id, 3);
+  EXPECT_EQ(byAge.back().id, 2);
+  std::vector<int> ids {};
+  for (const auto& s : byUser) {
+    ids.push_back(s.id);
+  }
+  EXPECT_EQ(ids, (std::vector<int> {3, 2, 0}));
+  MyIntrusiveList<Session, &Session::byUser> moved {std::move(byUser)};
+  EXPECT_TRUE(byUser.empty());
+  EXPECT_EQ(moved.size(), 3);
+  EXPECT_EQ(moved.back().id, 0);
+}
+
 int main(int argc, char* argv[]) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,131 @@
+#ifndef MAPPED_FILE_HPP_
+#define MAPPED_FILE_HPP_
+
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <system_error>
+
+#ifdef _WIN32
+// a CreateFileMapping version has yet to be built and tested on Windows
+#error "MappedFile is POSIX only for now"
+#endif
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// A file mapped read-write into memory, shared with the file itself, so
+// stores into data() end up in the file.  resize() grows the file and maps
+// it again, which may move data(); anything kept across a resize must be
+// an offset, not a pointer.  flush() returns once a range has reached the
+// disk.  Failures throw std::system_error.
+class MappedFile {
+public:
+    // opens path, creating it empty if it does not exist
+    explicit MappedFile(const std::string& path);
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile();
+
+    unsigned char* data() const;
+    std::size_t size() const;
+
+    // make the file bytes long, which must not be less than size()
+    void resize(std::size_t bytes);
+    // write [offset, offset + bytes) of the mapping through to the disk
+    void flush(std::size_t offset, std::size_t bytes);
+
+private:
+    int fd_{ -1 };
+    unsigned char* data_{ nullptr };
+    std::size_t size_{ 0 };
+
+    void map();
+    void unmap();
+    [[noreturn]] static void fail(const char* what);
+};
+
+inline MappedFile::MappedFile(const std::string& path) {
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd_ < 0) {
+        fail("MappedFile: open");
+    }
+    struct stat status;
+    if (::fstat(fd_, &status) != 0) {
+        // close may overwrite errno
+        int error = errno;
+        ::close(fd_);
+        errno = error;
+        fail("MappedFile: size");
+    }
+    size_ = static_cast<std::size_t>(status.st_size);
+    try {
+        map();
+    }
+    catch (...) {
+        // the error was taken from errno when it was thrown
+        ::close(fd_);
+        throw;
+    }
+}
+
+inline MappedFile::~MappedFile() {
+    unmap();
+    ::close(fd_);
+}
+
+inline void MappedFile::resize(std::size_t bytes) {
+    if (::ftruncate(fd_, static_cast<off_t>(bytes)) != 0) {
+        fail("MappedFile: resize");
+    }
+    unmap();
+    size_ = bytes;
+    map();
+}
+
+// msync wants a page-aligned start
+inline void MappedFile::flush(std::size_t offset, std::size_t bytes) {
+    if (bytes == 0) {
+        return;
+    }
+    auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    std::size_t start = offset / page * page;
+    if (::msync(data_ + start, offset + bytes - start, MS_SYNC) != 0) {
+        fail("MappedFile: flush");
+    }
+}
+
+// an empty file cannot be mapped; data() stays null until it grows
+inline void MappedFile::map() {
+    if (size_ == 0) {
+        return;
+    }
+    void* address = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (address == MAP_FAILED) {
+        fail("MappedFile: map");
+    }
+    data_ = static_cast<unsigned char*>(address);
+}
+
+inline void MappedFile::unmap() {
+    if (data_ != nullptr) {
+        ::munmap(data_, size_);
+        data_ = nullptr;
+    }
+}
+
+inline void MappedFile::fail(const char* what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+inline unsigned char* MappedFile::data() const {
+    return data_;
+}
+
+inline std::size_t MappedFile::size() const {
+    return size_;
+}
+
+#endif // MAPPED_FILE_HPP_
@@ -0,0 +1,371 @@
+#ifndef MAPPED_LIST_HPP_
+#define MAPPED_LIST_HPP_
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "mappedFile.hpp"
+
+// Doubly linked list kept in a memory-mapped file, so that it outlives the
+// process: reopening the file maps it again and the list is there, with no
+// parsing and no per-element work.  Nodes are linked by their byte offset
+// in the file (0 is null), which stays valid wherever the file is mapped
+// and when it is mapped again after growing.  Elements are stored as raw
+// bytes, so T must be trivially copyable, and a file is only meant to be
+// read back by a build with the same T.
+//
+// Elements are only appended; clear() empties the list.  Appends are
+// crash-consistent at flush points.  The header at the front of the file
+// holds the list as of the last flush(): flush first writes the nodes to
+// disk and only then the header, which fits in one disk sector.  After a
+// crash the file reopens as it was at the last flush, and appends made
+// since are dropped.  Elements changed in place through an iterator reach
+// the disk at the next flush, but a crash may catch such a change half
+// written.  The destructor flushes.
+//
+// Iterators hold an offset, not an address, so growing the file does not
+// invalidate them.
+template <typename T>
+class MappedList {
+    static_assert(std::is_trivially_copyable_v<T>, "elements are stored as raw bytes in the file");
+
+public:
+    struct Node {
+        std::uint64_t prev;
+        std::uint64_t next;
+        T data;
+    };
+
+    template <bool Const>
+    class BasicIterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+        using ListPtr = std::conditional_t<Const, const MappedList*, MappedList*>;
+
+        ListPtr list_{ nullptr };
+        std::uint64_t at_{ 0 };
+
+        BasicIterator() = default;
+        BasicIterator(ListPtr list, std::uint64_t at) : list_(list), at_(at) {}
+        template <bool WasConst, typename = std::enable_if_t<Const && !WasConst>>
+        BasicIterator(const BasicIterator<WasConst>& other) : list_(other.list_), at_(other.at_) {}
+
+        BasicIterator& operator++() {
+            at_ = list_->node(at_)->next;
+            return *this;
+        }
+
+        BasicIterator operator++(int) {
+            BasicIterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        // end() steps back to the last element
+        BasicIterator& operator--() {
+            at_ = at_ == 0 ? list_->tail_ : list_->node(at_)->prev;
+            return *this;
+        }
+
+        BasicIterator operator--(int) {
+            BasicIterator old = *this;
+            --*this;
+            return old;
+        }
+
+        reference operator*() const {
+            return list_->node(at_)->data;
+        }
+
+        pointer operator->() const {
+            return &list_->node(at_)->data;
+        }
+
+        friend bool operator==(const BasicIterator& a, const BasicIterator& b) {
+            return a.at_ == b.at_;
+        }
+
+        friend bool operator!=(const BasicIterator& a, const BasicIterator& b) {
+            return !(a == b);
+        }
+    };
+
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
+private:
+    // the list as of the last flush
+    struct Header {
+        std::uint64_t magic;
+        std::uint64_t version;
+        std::uint64_t nodeSize;
+        std::uint64_t head;
+        std::uint64_t tail;
+        std::uint64_t size;
+        // bytes in use, header included; nodes follow each other up to here
+        std::uint64_t used;
+    };
+
+    static constexpr std::uint64_t magic = 0x3174734c6470614dULL;
+    static constexpr std::uint64_t version = 1;
+    static constexpr std::size_t headerSize = (sizeof(Header) + alignof(Node) - 1) / alignof(Node) * alignof(Node);
+    static constexpr std::size_t initialBytes = std::size_t{ 1 } << 16;
+
+    MappedFile file_;
+    std::uint64_t head_{ 0 };
+    std::uint64_t tail_{ 0 };
+    std::uint64_t used_{ headerSize };
+    int size_{ 0 };
+
+public:
+    // open the list stored at path, or start an empty one there
+    explicit MappedList(const std::string& path);
+    MappedList(const MappedList&) = delete;
+    MappedList& operator=(const MappedList&) = delete;
+    // flushes; errors are swallowed, so call flush() first to see them
+    ~MappedList();
+
+    T& front();
+    const T& front() const;
+    T& back();
+    const T& back() const;
+
+    void push_back(const T& value);
+    template <typename... Args>
+    T& emplace_back(Args&&... args);
+
+    // grow the file to hold n elements in one step
+    void reserve(int n);
+
+    bool empty() const;
+    int size() const;
+
+    // empty the list and commit that at once; the file keeps its size
+    void clear();
+    // write every change so far to disk and make it what a reopen sees
+    void flush();
+
+    Iterator begin();
+    Iterator end();
+    ConstIterator begin() const;
+    ConstIterator end() const;
+    ConstIterator cbegin() const;
+    ConstIterator cend() const;
+
+private:
+    Header& header() const;
+    Node* node(std::uint64_t at) const;
+    static bool consistent(const Header& stored);
+    static bool isNode(std::uint64_t at, std::uint64_t used);
+    void commit();
+    void grow(std::size_t bytes);
+};
+
+template <typename T>
+MappedList<T>::MappedList(const std::string& path) : file_(path) {
+    if (file_.size() == 0) {
+        file_.resize(initialBytes);
+        header() = Header{ magic, version, sizeof(Node), 0, 0, 0, headerSize };
+        file_.flush(0, headerSize);
+        return;
+    }
+    const Header* stored = file_.size() < headerSize ? nullptr : &header();
+    if (stored == nullptr || stored->magic != magic || stored->version != version ||
+        stored->nodeSize != sizeof(Node) || stored->used < headerSize || stored->used > file_.size()) {
+        throw std::runtime_error("MappedList: " + path + " does not hold a list of this element type");
+    }
+    if (!consistent(*stored)) {
+        throw std::runtime_error("MappedList: " + path + " has a damaged header");
+    }
+    head_ = stored->head;
+    tail_ = stored->tail;
+    used_ = stored->used;
+    size_ = static_cast<int>(stored->size);
+    // cut off whatever was appended after the last flush
+    if (tail_ != 0) {
+        node(tail_)->next = 0;
+    }
+}
+
+template <typename T>
+MappedList<T>::~MappedList() {
+    try {
+        flush();
+    }
+    catch (...) {
+    }
+}
+
+template <typename T>
+T& MappedList<T>::front() {
+    return node(head_)->data;
+}
+
+template <typename T>
+const T& MappedList<T>::front() const {
+    return node(head_)->data;
+}
+
+template <typename T>
+T& MappedList<T>::back() {
+    return node(tail_)->data;
+}
+
+template <typename T>
+const T& MappedList<T>::back() const {
+    return node(tail_)->data;
+}
+
+template <typename T>
+void MappedList<T>::push_back(const T& value) {
+    emplace_back(value);
+}
+
+// The element is built before the file may grow, since growing remaps it
+// and args may refer into the list.  The node is written in full before
+// the old tail links to it.
+template <typename T>
+template <typename... Args>
+T& MappedList<T>::emplace_back(Args&&... args) {
+    T value(std::forward<Args>(args)...);
+    if (used_ + sizeof(Node) > file_.size()) {
+        grow(used_ + sizeof(Node));
+    }
+    std::uint64_t at = used_;
+    Node* added = ::new (static_cast<void*>(file_.data() + at)) Node{ tail_, 0, value };
+    if (tail_ == 0) {
+        head_ = at;
+    }
+    else {
+        node(tail_)->next = at;
+    }
+    tail_ = at;
+    used_ += sizeof(Node);
+    size_++;
+    return added->data;
+}
+
+template <typename T>
+void MappedList<T>::reserve(int n) {
+    std::size_t bytes = headerSize + static_cast<std::size_t>(n) * sizeof(Node);
+    if (bytes > file_.size()) {
+        file_.resize(bytes);
+    }
+}
+
+template <typename T>
+bool MappedList<T>::empty() const {
+    return size_ == 0;
+}
+
+template <typename T>
+int MappedList<T>::size() const {
+    return size_;
+}
+
+template <typename T>
+void MappedList<T>::clear() {
+    head_ = 0;
+    tail_ = 0;
+    used_ = headerSize;
+    size_ = 0;
+    commit();
+}
+
+// nodes first, so the header never points at a node that is not on disk
+template <typename T>
+void MappedList<T>::flush() {
+    file_.flush(headerSize, static_cast<std::size_t>(used_) - headerSize);
+    commit();
+}
+
+template <typename T>
+typename MappedList<T>::Iterator MappedList<T>::begin() {
+    return Iterator(this, head_);
+}
+
+template <typename T>
+typename MappedList<T>::Iterator MappedList<T>::end() {
+    return Iterator(this, 0);
+}
+
+template <typename T>
+typename MappedList<T>::ConstIterator MappedList<T>::begin() const {
+    return ConstIterator(this, head_);
+}
+
+template <typename T>
+typename MappedList<T>::ConstIterator MappedList<T>::end() const {
+    return ConstIterator(this, 0);
+}
+
+template <typename T>
+typename MappedList<T>::ConstIterator MappedList<T>::cbegin() const {
+    return begin();
+}
+
+template <typename T>
+typename MappedList<T>::ConstIterator MappedList<T>::cend() const {
+    return end();
+}
+
+template <typename T>
+typename MappedList<T>::Header& MappedList<T>::header() const {
+    return *reinterpret_cast<Header*>(file_.data());
+}
+
+template <typename T>
+typename MappedList<T>::Node* MappedList<T>::node(std::uint64_t at) const {
+    return reinterpret_cast<Node*>(file_.data() + at);
+}
+
+// whether the links and counts in a header could have come from commit(),
+// so that following them stays inside the file
+template <typename T>
+bool MappedList<T>::consistent(const Header& stored) {
+    std::uint64_t nodes = (stored.used - headerSize) / sizeof(Node);
+    if ((stored.used - headerSize) % sizeof(Node) != 0 || stored.size > nodes ||
+        stored.size > static_cast<std::uint64_t>(INT_MAX)) {
+        return false;
+    }
+    if (stored.head == 0 || stored.tail == 0 || stored.size == 0) {
+        return stored.head == 0 && stored.tail == 0 && stored.size == 0;
+    }
+    return isNode(stored.head, stored.used) && isNode(stored.tail, stored.used);
+}
+
+template <typename T>
+bool MappedList<T>::isNode(std::uint64_t at, std::uint64_t used) {
+    return at >= headerSize && at < used && (at - headerSize) % sizeof(Node) == 0;
+}
+
+// The header is only written here, so between flushes the file always
+// describes the last committed list, whenever its pages reach the disk.
+template <typename T>
+void MappedList<T>::commit() {
+    Header& stored = header();
+    stored.head = head_;
+    stored.tail = tail_;
+    stored.size = static_cast<std::uint64_t>(size_);
+    stored.used = used_;
+    file_.flush(0, headerSize);
+}
+
+// at least double, so appends remap O(log n) times
+template <typename T>
+void MappedList<T>::grow(std::size_t bytes) {
+    std::size_t doubled = file_.size() * 2;
+    file_.resize(bytes > doubled ? bytes : doubled);
+}
+
+#endif // MAPPED_LIST_HPP_
@@ -9,22 +9,57 @@ class MyInteger {
   int value {};
 
  public:
+  // operation counters, reset with clearCounts()
+  inline static int constructorCount = 0;
+  inline static int copyCount = 0;
+  inline static int moveCount = 0;
+
   // default constructor
-  MyInteger() {}
+  MyInteger() {
+    ++constructorCount;
+  }
 
   // constructor from an int
   // member initialisation list
-  explicit MyInteger(int input) : value {input} {}
+  explicit MyInteger(int input) : value {input} {
+    ++constructorCount;
+  }
 
   // copy constructor
-  MyInteger(const MyInteger& x) : value {x.value} {}
+  MyInteger(const MyInteger& x) : value {x.value} {
+    ++copyCount;
+  }
+
+  // move constructor
+  MyInteger(MyInteger&& x) noexcept : value {x.value} {
+    ++moveCount;
+  }
 
   // assignment operator
   MyInteger& operator=(const MyInteger& x) {
+    ++copyCount;
+    value = x.value;
+    return *this;
+  }
+
+  // move assignment operator
+  MyInteger& operator=(MyInteger&& x) noexcept {
+    ++moveCount;
     value = x.value;
     return *this;
   }
 
+  static void clearCounts() {
+    constructorCount = 0;
+    copyCount = 0;
+    moveCount = 0;
+  }
+
+  // the wrapped int
+  int get() const {
+    return value;
+  }
+
   // pre-increment operator
   MyInteger& operator++() {
     ++value;
@@ -2,321 +2,1481 @@
 #ifndef MY_LIST_HPP_
 #define MY_LIST_HPP_
 
+#include <cstddef>
+#include <functional>
 #include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "nodePool.hpp"
 
+// Node layout of MyList<T>.  By default the element sits inside its node
+// next to prev and next.  For a large T whose lists are mostly walked,
+// spliced or counted without reading the elements, specialise this with
+// split = true: nodes then hold only the links and a reference to the
+// element, which lives in a separate payload slab, so link-only walks touch
+// a few dense bytes per node instead of whole elements.  Iterators and the
+// rest of the interface are the same for both layouts.
 template <typename T>
+struct ListLayout {
+    static constexpr bool split = false;
+};
+
+// Circular doubly linked list around a sentinel embedded in the list
+// object.  The sentinel is end(): its next is the first node and its prev
+// the last, so every modifier relinks the same way whether the list is
+// empty or not, and end() is a plain address with no stores.
+//
+// splice, merge and sort only relink nodes: no element is copied and
+// nothing is allocated.  Moving nodes between two lists merges their node
+// pools, after which clear() returns nodes one at a time instead of
+// releasing the blocks wholesale.
+//
+// With N > 0 up to N nodes at a time are built in slots inside the list
+// object itself, and only nodes beyond those come from the pool, so a list
+// that never holds more than N elements never allocates.  The price is that a
+// node in those slots cannot leave the object: splice and merge from such
+// a list, and swap or move, move its elements into the receiving list's
+// storage, and iterators to them are invalidated.  The split layout has
+// no inline slots.
+template <typename T, std::size_t N = 0>
 class MyList {
 public:
-    struct Node {
-        T data{};
-        Node* prev{ nullptr };
-        Node* next{ nullptr };
-        Node(T input_data = T{}, Node* prevNode = nullptr, Node* nextNode = nullptr)
-            : data{ input_data }, prev{ prevNode }, next{ nextNode } {}
+    struct NodeBase {
+        NodeBase* prev{ nullptr };
+        NodeBase* next{ nullptr };
     };
 
-    class Iterator {
-    private:
+    struct InlineNode : NodeBase {
+        T data;
+        // builds data in place from args
+        template <typename... Args>
+        InlineNode(NodeBase* prevNode, NodeBase* nextNode, Args&&... args)
+            : NodeBase{ prevNode, nextNode }, data(std::forward<Args>(args)...) {}
+    };
+
+    struct SplitNode : NodeBase {
+        T& data;
+        // builds data from args in the payload slot the pool handed out
+        template <typename... Args>
+        SplitNode(void* payload, NodeBase* prevNode, NodeBase* nextNode, Args&&... args)
+            : NodeBase{ prevNode, nextNode }, data(*::new (payload) T(std::forward<Args>(args)...)) {}
+        SplitNode(const SplitNode&) = delete;
+        SplitNode& operator=(const SplitNode&) = delete;
+        ~SplitNode() {
+            data.~T();
+        }
+    };
 
+    using Node = std::conditional_t<ListLayout<T>::split, SplitNode, InlineNode>;
 
+    template <bool Const>
+    class BasicIterator {
     public:
-        Node* current_;
-        Iterator(Node* node) : current_(node) {}
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+        using NodePtr = std::conditional_t<Const, const NodeBase*, NodeBase*>;
+
+        NodePtr current_{ nullptr };
+
+        BasicIterator() = default;
+        BasicIterator(NodePtr node) : current_(node) {}
+        // Iterator converts to ConstIterator, not the other way round
+        template <bool WasConst, typename = std::enable_if_t<Const && !WasConst>>
+        BasicIterator(const BasicIterator<WasConst>& other) : current_(other.current_) {}
 
-        Iterator& operator++() {
+        BasicIterator& operator++() {
             current_ = current_->next;
             return *this;
         }
 
-        Iterator& operator--() {
+        BasicIterator operator++(int) {
+            BasicIterator old = *this;
+            current_ = current_->next;
+            return old;
+        }
+
+        BasicIterator& operator--() {
             current_ = current_->prev;
             return *this;
         }
 
-        T& operator*() const {
-            return current_->data;
+        BasicIterator operator--(int) {
+            BasicIterator old = *this;
+            current_ = current_->prev;
+            return old;
+        }
+
+        reference operator*() const {
+            return static_cast<std::conditional_t<Const, const Node*, Node*>>(current_)->data;
+        }
+
+        pointer operator->() const {
+            return &**this;
         }
 
-        friend bool operator==(const Iterator& a, const Iterator& b) {
+        friend bool operator==(const BasicIterator& a, const BasicIterator& b) {
             return a.current_ == b.current_;
         }
 
-        friend bool operator!=(const Iterator& a, const Iterator& b) {
+        friend bool operator!=(const BasicIterator& a, const BasicIterator& b) {
             return !(a == b);
         }
     };
 
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+    using ReverseIterator = std::reverse_iterator<Iterator>;
+    using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+
+    // nodes are carved out of a slab pool; several lists may share one
+    using Pool = std::conditional_t<ListLayout<T>::split, SplitNodePool<Node, T>, NodePool<Node>>;
+    static_assert(N == 0 || !ListLayout<T>::split, "split nodes cannot be kept inline");
+
 private:
-    Node* head;
-    Node* tail;
-    Node* endnode;
+    NodeBase endnode;
 
     int size_;
+    std::shared_ptr<Pool> pool_;
+    [[no_unique_address]] InlineNodes<Node, N> inline_;
+    // while compact_step is under way: the pool nodes are being moved out
+    // of, and the next node to move
+    std::shared_ptr<Pool> compactFrom_;
+    NodeBase* compactAt_{ nullptr };
+    // Split points for parallel walks: every checkpointStride_-th node in
+    // list order, collected as push_back appends.  Anything that removes or
+    // reorders nodes marks them stale, and split_points rebuilds them with
+    // one walk.
+    mutable std::vector<NodeBase*> checkpoints_;
+    mutable int checkpointStride_{ minCheckpointStride };
+    mutable int sinceCheckpoint_{ 0 };
+    mutable bool checkpointsValid_{ true };
 
 public:
     MyList();
+    explicit MyList(std::shared_ptr<Pool> pool);
     MyList(std::initializer_list<T> vals);
+    template <typename InputIt>
+    MyList(InputIt first, InputIt last);
     MyList(const MyList& other);
-    MyList& operator=(MyList other);
+    // nothrow unless elements have to move out of other's inline slots
+    MyList(MyList&& other) noexcept(N == 0);
+    MyList& operator=(const MyList& other);
+    MyList& operator=(MyList&& other) noexcept(N == 0);
     ~MyList();
 
+    void swap(MyList& other) noexcept(N == 0);
+
     T& front();
     const T& front() const;
     T& back();
     const T& back() const;
 
     void push_front(const T& value);
+    void push_front(T&& value);
+    template <typename... Args>
+    T& emplace_front(Args&&... args);
     void pop_front();
     void push_back(const T& value);
+    void push_back(T&& value);
+    template <typename... Args>
+    T& emplace_back(Args&&... args);
     void pop_back();
 
     void insert(const Iterator& position, const T& value);
+    void insert(const Iterator& position, T&& value);
+    // Copy [first, last) in front of position and return an iterator to the
+    // first copy (position if the range is empty).  With forward iterators
+    // room for every node is reserved in one block up front and the nodes
+    // are carved out of it in order.  They are chained together off to the
+    // side and spliced in at the end, so the list is unchanged if a copy
+    // throws.
+    template <typename InputIt>
+    Iterator insert(const Iterator& position, InputIt first, InputIt last);
+    // replace the contents with a copy of [first, last), which must not
+    // point into this list
+    template <typename InputIt>
+    void assign(InputIt first, InputIt last);
+    template <typename... Args>
+    Iterator emplace(const Iterator& position, Args&&... args);
     void erase(const Iterator& position);
+    // Filtering in one pass.  Survivors are relinked once per gap rather
+    // than once per removed node, and the removed nodes are only destroyed
+    // after the pass, so value or pred may refer to an element that is
+    // removed.  Their storage goes back to the pool's free list in one
+    // splice.  Each returns how many elements were removed, except range
+    // erase, which returns last.
+    Iterator erase(const Iterator& first, const Iterator& last);
+    template <typename Pred>
+    int remove_if(Pred pred);
+    int remove(const T& value);
+    // keep the first of every run of consecutive elements for which
+    // pred(first of run, element) holds
+    int unique();
+    template <typename BinaryPred>
+    int unique(BinaryPred pred);
+
+    // move all of other, the node at it, or [first, last) of other in
+    // front of position.  Iterators to the moved nodes stay valid and now
+    // refer into this list, except for nodes other held inline.
+    void splice(const Iterator& position, MyList& other);
+    void splice(const Iterator& position, MyList&& other);
+    void splice(const Iterator& position, MyList& other, const Iterator& it);
+    void splice(const Iterator& position, MyList& other, const Iterator& first, const Iterator& last);
+
+    // merge the sorted list other into this sorted list, leaving other
+    // empty.  Equal elements from this list stay in front of other's.
+    void merge(MyList& other);
+    template <typename Compare>
+    void merge(MyList& other, Compare comp);
+
+    // stable bottom-up merge sort; comp must not throw
+    void sort();
+    template <typename Compare>
+    void sort(Compare comp);
+    // The same sort spread over up to parts runs cut at the split points.
+    // run(tasks, f) must call f(0) ... f(tasks - 1), possibly at once, and
+    // return when all have finished (ThreadPool::run does).  Runs are
+    // sorted by one task each and then merged pairwise, also in parallel;
+    // comp is shared by the tasks.  Only links are touched, never the pool.
+    template <typename Compare, typename Run>
+    void sort(Compare comp, int parts, Run run);
+    // Stable LSD radix sort on an integral key, one byte per pass, that
+    // relinks nodes through 256 bucket chains and never moves an element.
+    // Bytes on which all keys agree are skipped.  key(element) is called
+    // once per element per pass, so it should be cheap.
+    void radix_sort();
+    template <typename Key>
+    void radix_sort(Key key);
+
+    // Bulk walks.  With distance > 0 they prefetch the element distance
+    // nodes ahead of the one being visited.  Each step still has to wait for
+    // the previous node's next link, so on out-of-order cores this rarely
+    // helps and it is off by default; in-order cores may gain from it.
+    // count_if does not depend on order and walks in from both ends at
+    // once, which keeps two cache misses in flight instead of one.
+    static constexpr int defaultPrefetchDistance = 0;
+    template <typename F>
+    void for_each(F f, int distance = defaultPrefetchDistance);
+    template <typename U, typename Op = std::plus<>>
+    U accumulate(U init, Op op = Op(), int distance = defaultPrefetchDistance) const;
+    template <typename Pred>
+    Iterator find_if(Pred pred, int distance = defaultPrefetchDistance);
+    template <typename Pred>
+    ConstIterator find_if(Pred pred, int distance = defaultPrefetchDistance) const;
+    template <typename Pred>
+    int count_if(Pred pred) const;
 
     bool empty() const;
     int size() const;
 
+    void clear();
+
+    // Move every node into one freshly allocated block, in list order, so
+    // that walking the list walks memory forwards.  Values and order are
+    // unchanged, but every iterator is invalidated.
+    void compact();
+    // compact() in bounded steps: move at most budget nodes per call and
+    // return true once the whole list has been moved.  Only iterators to
+    // the nodes a step moves are invalidated.  Pushes, inserts and erases
+    // may come between steps; splice, merge, sort, clear and the bulk
+    // removals end the compaction early, leaving the list valid but only
+    // partly compacted.
+    bool compact_step(int budget);
+
+    // at most parts + 1 positions, from begin() to end(), that cut the list
+    // into roughly equal runs.  Free while the list has only grown since the
+    // last call; otherwise it costs one walk over the links.
+    std::vector<ConstIterator> split_points(int parts) const;
+    std::vector<Iterator> split_points(int parts);
+
     Iterator begin();
     Iterator end();
+    ConstIterator begin() const;
+    ConstIterator end() const;
+    ConstIterator cbegin() const;
+    ConstIterator cend() const;
+    ReverseIterator rbegin();
+    ReverseIterator rend();
+    ConstReverseIterator rbegin() const;
+    ConstReverseIterator rend() const;
 
 private:
     void initialize();
-    void clear();
+    Pool& pool();
+    template <typename... Args>
+    Node* link(NodeBase* position, Args&&... args);
+    void unlink(NodeBase* node);
+    template <typename Drop>
+    int dropWhere(NodeBase* first, NodeBase* last, Drop drop);
+    static void relink(NodeBase& to, NodeBase& from);
+    void sharePool(MyList& other);
+    void destroy(NodeBase* node);
+    NodeBase* relocate(NodeBase* node, InlineNodes<Node, N>& from);
+    void adopt(MyList& from, NodeBase* first, NodeBase* last);
+    static void transfer(NodeBase* position, NodeBase* first, NodeBase* last);
+    template <typename Compare>
+    static NodeBase* mergeRuns(NodeBase* a, NodeBase* b, Compare& comp);
+    template <typename Compare>
+    static NodeBase* sortChain(NodeBase* chain, Compare& comp);
+    void relinkSorted(NodeBase* sorted);
+    template <typename Visit>
+    NodeBase* walk(Visit visit, int distance) const;
+    static void prefetch(const NodeBase* node);
+    void moveNode(NodeBase* node);
+    void finishCompaction();
+    void settle();
+    void noteAppended(NodeBase* node);
+    void resetCheckpoints(bool valid) const;
+    void rebuildCheckpoints() const;
+    // kept between 64 and 128 per list once it is long enough; runs shorter
+    // than the minimum stride are not worth a thread, and short lists then
+    // never allocate the vector
+    static constexpr std::size_t maxCheckpoints = 128;
+    static constexpr int minCheckpointStride = 64;
 };
 
-template <typename T>
-MyList<T>::MyList() {
+template <typename T, std::size_t N>
+MyList<T, N>::MyList() {
     initialize();
 }
 
-template <typename T>
-MyList<T>::MyList(std::initializer_list<T> vals) {
+template <typename T, std::size_t N>
+MyList<T, N>::MyList(std::shared_ptr<Pool> pool) {
     initialize();
-    for (const auto& val : vals) {
-        push_back(val);
-    }
+    pool_ = std::move(pool);
+}
 
+template <typename T, std::size_t N>
+MyList<T, N>::MyList(std::initializer_list<T> vals) {
+    initialize();
+    insert(end(), vals.begin(), vals.end());
 }
 
-template <typename T>
-MyList<T>::MyList(const MyList& other) {
+template <typename T, std::size_t N>
+template <typename InputIt>
+MyList<T, N>::MyList(InputIt first, InputIt last) {
     initialize();
-    for (auto current = other.head; current != nullptr; current = current->next) {
-        push_back(current->data);
+    insert(end(), first, last);
+}
+
+template <typename T, std::size_t N>
+MyList<T, N>::MyList(const MyList& other) {
+    initialize();
+    insert(end(), other.begin(), other.end());
+}
+
+// steals the nodes and the pool; other is left empty
+template <typename T, std::size_t N>
+MyList<T, N>::MyList(MyList&& other) noexcept(N == 0) {
+    initialize();
+    swap(other);
+}
+
+template <typename T, std::size_t N>
+MyList<T, N>& MyList<T, N>::operator=(const MyList& other) {
+    if (this != &other) {
+        MyList copy(other);
+        swap(copy);
     }
+    return *this;
 }
 
-template <typename T>
-MyList<T>& MyList<T>::operator=(MyList other) {
-    std::swap(head, other.head);
-    std::swap(tail, other.tail);
-    std::swap(size_, other.size_);
+// the old contents go to other and are released with it
+template <typename T, std::size_t N>
+MyList<T, N>& MyList<T, N>::operator=(MyList&& other) noexcept(N == 0) {
+    swap(other);
     return *this;
 }
 
-template <typename T>
-MyList<T>::~MyList() {
+template <typename T, std::size_t N>
+MyList<T, N>::~MyList() {
     clear();
 }
 
-template <typename T>
-T& MyList<T>::front() {
-    return head->data;
+// each sentinel lives in its own object, so the chains are moved across
+// rather than swapping the sentinels themselves.  Inline nodes cannot move,
+// so each list then rebuilds the ones it received in its own storage.  The
+// first adopt empties other's slots, so the second always fits inline;
+// whatever does not fit in ours goes to our pool.
+template <typename T, std::size_t N>
+void MyList<T, N>::swap(MyList& other) noexcept(N == 0) {
+    if (&other == this) {
+        return;
+    }
+    NodeBase temp;
+    relink(temp, endnode);
+    relink(endnode, other.endnode);
+    relink(other.endnode, temp);
+    std::swap(size_, other.size_);
+    std::swap(pool_, other.pool_);
+    std::swap(compactFrom_, other.compactFrom_);
+    std::swap(compactAt_, other.compactAt_);
+    std::swap(checkpoints_, other.checkpoints_);
+    std::swap(checkpointStride_, other.checkpointStride_);
+    std::swap(sinceCheckpoint_, other.sinceCheckpoint_);
+    std::swap(checkpointsValid_, other.checkpointsValid_);
+    adopt(other, endnode.next, &endnode);
+    other.adopt(*this, other.endnode.next, &other.endnode);
 }
 
-template <typename T>
-const T& MyList<T>::front() const {
-    return head->data;
+template <typename T, std::size_t N>
+T& MyList<T, N>::front() {
+    return static_cast<Node*>(endnode.next)->data;
 }
 
-template <typename T>
-T& MyList<T>::back() {
-    return tail->data;
+template <typename T, std::size_t N>
+const T& MyList<T, N>::front() const {
+    return static_cast<const Node*>(endnode.next)->data;
 }
 
-template <typename T>
-const T& MyList<T>::back() const {
-    return tail->data;
+template <typename T, std::size_t N>
+T& MyList<T, N>::back() {
+    return static_cast<Node*>(endnode.prev)->data;
 }
 
-template <typename T>
-void MyList<T>::push_front(const T& value) {
-    Node* newNode = new Node(value, nullptr, head);
-    if (head != nullptr) {
-        head->prev = newNode;
+template <typename T, std::size_t N>
+const T& MyList<T, N>::back() const {
+    return static_cast<const Node*>(endnode.prev)->data;
+}
+
+template <typename T, std::size_t N>
+void MyList<T, N>::push_front(const T& value) {
+    emplace_front(value);
+}
+
+template <typename T, std::size_t N>
+void MyList<T, N>::push_front(T&& value) {
+    emplace_front(std::move(value));
+}
+
+template <typename T, std::size_t N>
+template <typename... Args>
+T& MyList<T, N>::emplace_front(Args&&... args) {
+    return link(endnode.next, std::forward<Args>(args)...)->data;
+}
+
+template <typename T, std::size_t N>
+void MyList<T, N>::pop_front() {
+    if (size_ > 0) {
+        unlink(endnode.next);
     }
-    else {
-        tail = newNode; // if the list was empty, set tail to newNode
+}
+
+template <typename T, std::size_t N>
+void MyList<T, N>::push_back(const T& value) {
+    emplace_back(value);
+}
+
+template <typename T, std::size_t N>
+void MyList<T, N>::push_back(T&& value) {
+    emplace_back(std::move(value));
+}
+
+template <typename T, std::size_t N>
+template <typename... Args>
+T& MyList<T, N>::emplace_back(Args&&... args) {
+    return link(&endnode, std::forward<Args>(args)...)->data;
+}
+
+template <typename T, std::size_t N>
+void MyList<T, N>::pop_back() {
+    if (size_ > 0) {
+        unlink(endnode.prev);
     }
-    head = newNode;
-    size_++;
 }
 
-template <typename T>
-void MyList<T>::pop_front() {
-    if (head != nullptr) {
-        Node* temp = head;
-        head = head->next;
-        if (head != nullptr) {
-            head->prev = nullptr;
+template <typename T, std::size_t N>
+bool MyList<T, N>::empty() const {
+    return size_ == 0;
+}
+
+template <typename T, std::size_t N>
+int MyList<T, N>::size() const {
+    return size_;
+}
+
+template <typename T, std::size_t N>
+void MyList<T, N>::initialize() {
+    endnode.prev = &endnode;
+    endnode.next = &endnode;
+    size_ = 0;
+}
+
+// the pool is created on first use, so empty and moved-from lists own none.
+// A pool merged into another by a splice is swapped for the survivor here.
+template <typename T, std::size_t N>
+typename MyList<T, N>::Pool& MyList<T, N>::pool() {
+    if (pool_ == nullptr) {
+        pool_ = std::make_shared<Pool>();
+    }
+    else if (pool_->forwarded()) {
+        pool_ = Pool::root(pool_);
+    }
+    return *pool_;
+}
+
+template <typename T, std::size_t N>
+void MyList<T, N>::clear() {
+    settle();
+    // a list that never allocated has no pool; its nodes, if any, are inline
+    Pool* nodes = pool_ == nullptr ? nullptr : &pool();
+    // the pool holds only our nodes: run the element destructors (if any)
+    // and hand the blocks back wholesale instead of freeing node by node
+    bool wholesale = nodes == nullptr || pool_.use_count() == 1;
+    if (!wholesale || !std::is_trivially_destructible_v<T> || !inline_.empty()) {
+        for (NodeBase* current = endnode.next; current != &endnode;) {
+            NodeBase* next = current->next;
+            if (inline_.owns(static_cast<Node*>(current))) {
+                inline_.destroy(static_cast<Node*>(current));
+            }
+            else if (wholesale) {
+                static_cast<Node*>(current)->~Node();
+            }
+            else {
+                nodes->destroy(static_cast<Node*>(current));
+            }
+            current = next;
         }
-        else {
-            tail = nullptr; // if the list is now empty, set tail to nullptr
+    }
+    if (nodes != nullptr && wholesale) {
+        nodes->release();
+    }
+    initialize();
+    resetCheckpoints(true);
+}
+
+template <typename T, std::size_t N>
+void MyList<T, N>::compact() {
+    settle();
+    compact_step(size_);
+}
+
+// the first step swaps in a new pool with room for every node in one
+// block; nodes are then moved over from the front, one relink each
+template <typename T, std::size_t N>
+bool MyList<T, N>::compact_step(int budget) {
+    if (compactFrom_ == nullptr) {
+        if (pool_ == nullptr || size_ == 0) {
+            return true;
+        }
+        compactFrom_ = Pool::root(pool_);
+        pool_ = std::make_shared<Pool>();
+        pool_->reserve(static_cast<std::size_t>(size_));
+        compactAt_ = endnode.next;
+    }
+    for (int moved = 0; moved < budget && compactAt_ != &endnode; ++moved) {
+        NodeBase* node = compactAt_;
+        NodeBase* next = node->next;
+        // nodes inserted since the compaction began are already in place,
+        // and inline ones have nowhere better to be
+        if (!inline_.owns(static_cast<Node*>(node)) && !pool_->owns(static_cast<Node*>(node))) {
+            moveNode(node);
         }
-        delete temp;
-        size_--;
+        compactAt_ = next;
     }
+    if (compactAt_ != &endnode) {
+        return false;
+    }
+    finishCompaction();
+    return true;
 }
 
-template <typename T>
-void MyList<T>::push_back(const T& value) {
-    Node* newNode = new Node(value, tail, nullptr);
-    if (tail != nullptr) {
-        tail->next = newNode;
+template <typename T, std::size_t N>
+std::vector<typename MyList<T, N>::ConstIterator> MyList<T, N>::split_points(int parts) const {
+    if (!checkpointsValid_) {
+        rebuildCheckpoints();
     }
-    else {
-        head = newNode; // if the list was empty, set head to newNode
+    std::vector<ConstIterator> points{ begin() };
+    std::size_t count = checkpoints_.size();
+    if (parts > 1 && count > 0) {
+        // the checkpoints are evenly spaced, so take every count/parts-th
+        for (int i = 1; i < parts; ++i) {
+            std::size_t k = count * static_cast<std::size_t>(i) / static_cast<std::size_t>(parts);
+            ConstIterator point(checkpoints_[k]);
+            if (point != points.back()) {
+                points.push_back(point);
+            }
+        }
+    }
+    if (points.back() != end()) {
+        points.push_back(end());
     }
+    return points;
+}
 
-    tail = newNode;
-    tail->next = endnode;
-    size_++;
+template <typename T, std::size_t N>
+std::vector<typename MyList<T, N>::Iterator> MyList<T, N>::split_points(int parts) {
+    std::vector<Iterator> points;
+    for (const auto& point : static_cast<const MyList&>(*this).split_points(parts)) {
+        points.emplace_back(const_cast<NodeBase*>(point.current_));
+    }
+    return points;
 }
 
-template <typename T>
-void MyList<T>::pop_back() {
-    if (tail != nullptr) {
-        Node* temp = tail;
-        tail = tail->prev;
-        if (tail != nullptr) {
-            tail->next = nullptr;
+template <typename T, std::size_t N>
+void MyList<T, N>::insert(const Iterator& position, const T& value) {
+    emplace(position, value);
+}
+
+template <typename T, std::size_t N>
+void MyList<T, N>::insert(const Iterator& position, T&& value) {
+    emplace(position, std::move(value));
+}
+
+template <typename T, std::size_t N>
+template <typename InputIt>
+typename MyList<T, N>::Iterator MyList<T, N>::insert(const Iterator& position, InputIt first, InputIt last) {
+    using Category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>) {
+        auto count = static_cast<std::size_t>(std::distance(first, last));
+        if (count > inline_.available()) {
+            pool().reserve(count - inline_.available());
+        }
+    }
+    // the new nodes hang off chain until they are all built; appended
+    // nodes are checkpointed on the way, as push_back would
+    bool appended = position.current_ == &endnode;
+    if (!appended) {
+        resetCheckpoints(false);
+    }
+    NodeBase chain;
+    chain.prev = &chain;
+    chain.next = &chain;
+    int count = 0;
+    try {
+        for (; first != last; ++first) {
+            Node* node = inline_.create(chain.prev, &chain, *first);
+            if (node == nullptr) {
+                node = pool().createFresh(chain.prev, &chain, *first);
+            }
+            chain.prev->next = node;
+            chain.prev = node;
+            ++count;
+            if (appended) {
+                noteAppended(node);
+            }
+        }
+    }
+    catch (...) {
+        resetCheckpoints(false);
+        for (NodeBase* current = chain.next; current != &chain;) {
+            NodeBase* next = current->next;
+            destroy(current);
+            current = next;
+        }
+        throw;
+    }
+    if (count == 0) {
+        return position;
+    }
+    NodeBase* inserted = chain.next;
+    transfer(position.current_, chain.next, &chain);
+    size_ += count;
+    return Iterator(inserted);
+}
+
+template <typename T, std::size_t N>
+template <typename InputIt>
+void MyList<T, N>::assign(InputIt first, InputIt last) {
+    clear();
+    insert(end(), first, last);
+}
+
+template <typename T, std::size_t N>
+template <typename... Args>
+typename MyList<T, N>::Iterator MyList<T, N>::emplace(const Iterator& position, Args&&... args) {
+    return Iterator(link(position.current_, std::forward<Args>(args)...));
+}
+
+template <typename T, std::size_t N>
+void MyList<T, N>::erase(const Iterator& position) {
+    unlink(position.current_);
+}
+
+template <typename T, std::size_t N>
+typename MyList<T, N>::Iterator MyList<T, N>::erase(const Iterator& first, const Iterator& last) {
+    if (first != last) {
+        dropWhere(first.current_, last.current_, [](NodeBase*, NodeBase*) { return true; });
+    }
+    return last;
+}
+
+template <typename T, std::size_t N>
+template <typename Pred>
+int MyList<T, N>::remove_if(Pred pred) {
+    return dropWhere(endnode.next, &endnode, [&](NodeBase* node, NodeBase*) {
+        return static_cast<bool>(pred(static_cast<Node*>(node)->data));
+    });
+}
+
+template <typename T, std::size_t N>
+int MyList<T, N>::remove(const T& value) {
+    return remove_if([&](const T& element) { return element == value; });
+}
+
+template <typename T, std::size_t N>
+int MyList<T, N>::unique() {
+    return unique(std::equal_to<>{});
+}
+
+template <typename T, std::size_t N>
+template <typename BinaryPred>
+int MyList<T, N>::unique(BinaryPred pred) {
+    if (size_ < 2) {
+        return 0;
+    }
+    return dropWhere(endnode.next->next, &endnode, [&](NodeBase* node, NodeBase* kept) {
+        return static_cast<bool>(pred(static_cast<Node*>(kept)->data, static_cast<Node*>(node)->data));
+    });
+}
+
+template <typename T, std::size_t N>
+void MyList<T, N>::splice(const Iterator& position, MyList& other) {
+    if (&other == this || other.empty()) {
+        return;
+    }
+    settle();
+    other.settle();
+    resetCheckpoints(false);
+    other.resetCheckpoints(false);
+    sharePool(other);
+    adopt(other, other.endnode.next, &other.endnode);
+    transfer(position.current_, other.endnode.next, &other.endnode);
+    size_ += other.size_;
+    other.size_ = 0;
+}
+
+template <typename T, std::size_t N>
+void MyList<T, N>::splice(const Iterator& position, MyList&& other) {
+    splice(position, other);
+}
+
+template <typename T, std::size_t N>
+void MyList<T, N>::splice(const Iterator& position, MyList& other, const Iterator& it) {
+    NodeBase* node = it.current_;
+    if (position.current_ == node || position.current_ == node->next) {
+        return;
+    }
+    settle();
+    other.settle();
+    resetCheckpoints(false);
+    other.resetCheckpoints(false);
+    if (&other != this) {
+        sharePool(other);
+        if (other.inline_.owns(static_cast<Node*>(node))) {
+            node = relocate(node, other.inline_);
+        }
+        other.size_--;
+        size_++;
+    }
+    transfer(position.current_, node, node->next);
+}
+
+template <typename T, std::size_t N>
+void MyList<T, N>::splice(const Iterator& position, MyList& other, const Iterator& first, const Iterator& last) {
+    if (first == last) {
+        return;
+    }
+    settle();
+    other.settle();
+    resetCheckpoints(false);
+    other.resetCheckpoints(false);
+    if (&other != this) {
+        int count = 0;
+        for (NodeBase* current = first.current_; current != last.current_; current = current->next) {
+            ++count;
+        }
+        sharePool(other);
+        NodeBase* before = first.current_->prev;
+        adopt(other, first.current_, last.current_);
+        other.size_ -= count;
+        size_ += count;
+        transfer(position.current_, before->next, last.current_);
+        return;
+    }
+    transfer(position.current_, first.current_, last.current_);
+}
+
+template <typename T, std::size_t N>
+void MyList<T, N>::merge(MyList& other) {
+    merge(other, std::less<>());
+}
+
+template <typename T, std::size_t N>
+template <typename Compare>
+void MyList<T, N>::merge(MyList& other, Compare comp) {
+    if (&other == this || other.empty()) {
+        return;
+    }
+    settle();
+    other.settle();
+    resetCheckpoints(false);
+    other.resetCheckpoints(false);
+    sharePool(other);
+    adopt(other, other.endnode.next, &other.endnode);
+    NodeBase* a = endnode.next;
+    NodeBase* b = other.endnode.next;
+    while (b != &other.endnode) {
+        if (a == &endnode) {
+            // everything left in other goes after our last node
+            transfer(&endnode, b, &other.endnode);
+            break;
+        }
+        if (comp(static_cast<Node*>(b)->data, static_cast<Node*>(a)->data)) {
+            NodeBase* next = b->next;
+            transfer(a, b, next);
+            b = next;
         }
         else {
-            head = nullptr; // if the list is now empty, set head to nullptr
+            a = a->next;
         }
+    }
+    size_ += other.size_;
+    other.size_ = 0;
+}
+
+template <typename T, std::size_t N>
+void MyList<T, N>::sort() {
+    sort(std::less<>());
+}
 
-        delete temp;
-        size_--;
+template <typename T, std::size_t N>
+template <typename Compare>
+void MyList<T, N>::sort(Compare comp) {
+    if (size_ < 2) {
+        return;
     }
+    settle();
+    resetCheckpoints(false);
+    endnode.prev->next = nullptr;
+    relinkSorted(sortChain(endnode.next, comp));
 }
 
-template <typename T>
-bool MyList<T>::empty() const {
-    return size_ == 0;
+// each run is cut off as a null-terminated chain; tasks only ever touch
+// the chains they were given
+template <typename T, std::size_t N>
+template <typename Compare, typename Run>
+void MyList<T, N>::sort(Compare comp, int parts, Run run) {
+    if (size_ < 2) {
+        return;
+    }
+    std::vector<Iterator> points = split_points(parts);
+    settle();
+    resetCheckpoints(false);
+    int count = static_cast<int>(points.size()) - 1;
+    std::vector<NodeBase*> runs(static_cast<std::size_t>(count));
+    for (int i = 0; i < count; ++i) {
+        runs[i] = points[i].current_;
+        points[i + 1].current_->prev->next = nullptr;
+    }
+    run(count, [&](int i) {
+        runs[i] = sortChain(runs[i], comp);
+    });
+    // run i absorbs run i + width; the earlier run goes on the left, so
+    // the result is stable
+    for (int width = 1; width < count; width *= 2) {
+        run((count + 2 * width - 1) / (2 * width), [&](int pair) {
+            int i = 2 * width * pair;
+            if (i + width < count) {
+                runs[i] = mergeRuns(runs[i], runs[i + width], comp);
+            }
+        });
+    }
+    relinkSorted(runs[0]);
 }
 
-template <typename T>
-int MyList<T>::size() const {
-    return size_;
+template <typename T, std::size_t N>
+void MyList<T, N>::radix_sort() {
+    static_assert(std::is_integral_v<T>, "radix_sort() needs integral elements; pass a key otherwise");
+    radix_sort([](const T& value) { return value; });
 }
 
-template <typename T>
-void MyList<T>::initialize() {
-    head = nullptr;
-    tail = nullptr;
-    endnode = new Node;
-    size_ = 0;
+// Signed keys have their sign bit flipped, which maps them onto unsigned
+// keys in the same order.  A first walk finds the bits that differ between
+// keys; each remaining pass deals the chain into buckets by one byte of
+// the key, keeping order within a bucket, and strings the buckets back
+// together.
+template <typename T, std::size_t N>
+template <typename Key>
+void MyList<T, N>::radix_sort(Key key) {
+    using K = std::decay_t<decltype(key(std::declval<const T&>()))>;
+    static_assert(std::is_integral_v<K>, "radix_sort keys must be integral");
+    using U = std::make_unsigned_t<K>;
+    if (size_ < 2) {
+        return;
+    }
+    settle();
+    resetCheckpoints(false);
+    constexpr U flip = std::is_signed_v<K> ? static_cast<U>(U{ 1 } << (sizeof(U) * 8 - 1)) : U{ 0 };
+    auto keyOf = [&](NodeBase* node) {
+        return static_cast<U>(static_cast<U>(key(static_cast<const Node*>(node)->data)) ^ flip);
+    };
+    U all = static_cast<U>(~U{ 0 });
+    U any = 0;
+    for (NodeBase* current = endnode.next; current != &endnode; current = current->next) {
+        U k = keyOf(current);
+        all &= k;
+        any |= k;
+    }
+    U differ = all ^ any;
+    endnode.prev->next = nullptr;
+    NodeBase* chain = endnode.next;
+    for (std::size_t shift = 0; shift < sizeof(U) * 8; shift += 8) {
+        if (((differ >> shift) & 0xff) == 0) {
+            continue;
+        }
+        NodeBase* heads[256] = {};
+        NodeBase* tails[256];
+        for (NodeBase* current = chain; current != nullptr; current = current->next) {
+            auto digit = static_cast<std::size_t>((keyOf(current) >> shift) & 0xff);
+            if (heads[digit] == nullptr) {
+                heads[digit] = current;
+            }
+            else {
+                tails[digit]->next = current;
+            }
+            tails[digit] = current;
+        }
+        NodeBase head;
+        NodeBase* tail = &head;
+        for (std::size_t digit = 0; digit < 256; ++digit) {
+            if (heads[digit] != nullptr) {
+                tail->next = heads[digit];
+                tail = tails[digit];
+            }
+        }
+        tail->next = nullptr;
+        chain = head.next;
+    }
+    relinkSorted(chain);
 }
 
-template <typename T>
-void MyList<T>::clear() {
-    while (head != nullptr) {
-        Node* temp = head;
-        head = head->next;
-        delete temp;
+template <typename T, std::size_t N>
+typename MyList<T, N>::Iterator MyList<T, N>::begin() {
+    return Iterator(endnode.next);
+}
+
+template <typename T, std::size_t N>
+typename MyList<T, N>::Iterator MyList<T, N>::end() {
+    return Iterator(&endnode);
+}
+
+template <typename T, std::size_t N>
+typename MyList<T, N>::ConstIterator MyList<T, N>::begin() const {
+    return ConstIterator(endnode.next);
+}
+
+template <typename T, std::size_t N>
+typename MyList<T, N>::ConstIterator MyList<T, N>::end() const {
+    return ConstIterator(&endnode);
+}
+
+template <typename T, std::size_t N>
+typename MyList<T, N>::ConstIterator MyList<T, N>::cbegin() const {
+    return begin();
+}
+
+template <typename T, std::size_t N>
+typename MyList<T, N>::ConstIterator MyList<T, N>::cend() const {
+    return end();
+}
+
+template <typename T, std::size_t N>
+template <typename F>
+void MyList<T, N>::for_each(F f, int distance) {
+    walk([&](NodeBase* node) {
+        f(static_cast<Node*>(node)->data);
+        return false;
+    }, distance);
+}
+
+template <typename T, std::size_t N>
+template <typename U, typename Op>
+U MyList<T, N>::accumulate(U init, Op op, int distance) const {
+    walk([&](NodeBase* node) {
+        init = op(std::move(init), static_cast<const Node*>(node)->data);
+        return false;
+    }, distance);
+    return init;
+}
+
+template <typename T, std::size_t N>
+template <typename Pred>
+typename MyList<T, N>::Iterator MyList<T, N>::find_if(Pred pred, int distance) {
+    return Iterator(walk([&](NodeBase* node) {
+        return static_cast<bool>(pred(static_cast<Node*>(node)->data));
+    }, distance));
+}
+
+template <typename T, std::size_t N>
+template <typename Pred>
+typename MyList<T, N>::ConstIterator MyList<T, N>::find_if(Pred pred, int distance) const {
+    return ConstIterator(walk([&](NodeBase* node) {
+        return static_cast<bool>(pred(static_cast<const Node*>(node)->data));
+    }, distance));
+}
+
+// the front and back walks are independent chains of loads, so their
+// misses overlap
+template <typename T, std::size_t N>
+template <typename Pred>
+int MyList<T, N>::count_if(Pred pred) const {
+    int count = 0;
+    const NodeBase* front = endnode.next;
+    const NodeBase* back = endnode.prev;
+    for (int i = size_ / 2; i > 0; --i) {
+        count += pred(static_cast<const Node*>(front)->data) ? 1 : 0;
+        count += pred(static_cast<const Node*>(back)->data) ? 1 : 0;
+        front = front->next;
+        back = back->prev;
     }
-    tail = nullptr;
-    size_ = 0;
+    if (size_ % 2 != 0) {
+        count += pred(static_cast<const Node*>(front)->data) ? 1 : 0;
+    }
+    return count;
+}
+
+template <typename T, std::size_t N>
+typename MyList<T, N>::ReverseIterator MyList<T, N>::rbegin() {
+    return ReverseIterator(end());
 }
 
+template <typename T, std::size_t N>
+typename MyList<T, N>::ReverseIterator MyList<T, N>::rend() {
+    return ReverseIterator(begin());
+}
 
+template <typename T, std::size_t N>
+typename MyList<T, N>::ConstReverseIterator MyList<T, N>::rbegin() const {
+    return ConstReverseIterator(end());
+}
 
-template <typename T>
-void MyList<T>::insert(const Iterator& position, const T& value) {
-    //if (position.current_ ->next== nullptr) {
-    //    push_back(value);
-    //    return;
-    //}
-    //if (position.current_->prev == nullptr) {
-        //push_front(value);
-        //return;
-   // }
-
-    if (position.current_ == endnode) {
-        Node *newNode = new Node(value, position.current_->prev, position.current_);
-        position.current_->prev = newNode;
-        tail = position.current_->prev;
-   
-    }
-    else if (position.current_ == head) {
-        Node *newNode = new Node(value, position.current_->prev, position.current_);
-        head->prev = newNode;
-        head = newNode;
-
-    }
-    else if (position.current_ != head) {
-        Node *newNode = new Node(value, position.current_->prev, position.current_);
-        position.current_->prev->next = newNode;
-        //position.current_->next->prev = newNode;
-        position.current_->prev = newNode;
-
-    }
-
-    /* if (position.current_->prev != nullptr) {
-         position.current_->prev->next = newNode;
-     }
-     else {
-         head = newNode;
-     }*/
-     //position.current_->prev = newNode;
-     //endnode->prev = tail;
+template <typename T, std::size_t N>
+typename MyList<T, N>::ConstReverseIterator MyList<T, N>::rend() const {
+    return ConstReverseIterator(begin());
+}
 
+// allocate a node from args and link it in before position
+template <typename T, std::size_t N>
+template <typename... Args>
+typename MyList<T, N>::Node* MyList<T, N>::link(NodeBase* position, Args&&... args) {
+    Node* newNode = inline_.create(position->prev, position, std::forward<Args>(args)...);
+    if (newNode == nullptr) {
+        newNode = pool().create(position->prev, position, std::forward<Args>(args)...);
+    }
+    position->prev->next = newNode;
+    position->prev = newNode;
     size_++;
+    // only appends keep the checkpoints in order
+    if (position == &endnode) {
+        noteAppended(newNode);
+    }
+    else {
+        resetCheckpoints(false);
+    }
+    return newNode;
 }
 
-template <typename T>
-void MyList<T>::erase(const Iterator& position) {
-    if (position.current_ == nullptr) {
+template <typename T, std::size_t N>
+void MyList<T, N>::unlink(NodeBase* node) {
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+    size_--;
+    resetCheckpoints(false);
+    if (compactFrom_ == nullptr) {
+        destroy(node);
+        return;
+    }
+    // mid-compaction the node may still belong to the old pool
+    if (node == compactAt_) {
+        compactAt_ = node->next;
+    }
+    if (inline_.owns(static_cast<Node*>(node))) {
+        inline_.destroy(static_cast<Node*>(node));
+    }
+    else if (pool_->owns(static_cast<Node*>(node))) {
+        pool_->destroy(static_cast<Node*>(node));
+    }
+    else {
+        compactFrom_ = Pool::root(compactFrom_);
+        compactFrom_->destroy(static_cast<Node*>(node));
+    }
+    if (compactAt_ == &endnode) {
+        finishCompaction();
+    }
+}
+
+// Unhook every node in [first, last) for which drop(node, kept) holds,
+// kept being the last node left in place before it.  A kept node is only
+// relinked when a gap has just closed in front of it.  Nodes with nothing
+// to destroy are freed as they are met: a freed slot is not reused before
+// the pass ends, so its element can still be read.  Others are chained
+// through next and destroyed after the pass.  Freed storage goes back to
+// the pool in one splice at the end, also if drop throws, in which case
+// the rest of the range stays as it was.
+template <typename T, std::size_t N>
+template <typename Drop>
+int MyList<T, N>::dropWhere(NodeBase* first, NodeBase* last, Drop drop) {
+    settle();
+    constexpr bool freeAtOnce = std::is_trivially_destructible_v<Node>;
+    // a list that never allocated has no pool; its nodes are all inline
+    Pool* nodes = pool_ == nullptr ? nullptr : &pool();
+    typename Pool::Freed freed;
+    auto discard = [&](NodeBase* node) {
+        if (inline_.owns(static_cast<Node*>(node))) {
+            inline_.destroy(static_cast<Node*>(node));
+        }
+        else {
+            nodes->destroy(static_cast<Node*>(node), freed);
+        }
+    };
+    NodeBase* kept = first->prev;
+    NodeBase* current = first;
+    NodeBase* dropped = nullptr;
+    int count = 0;
+    auto close = [&] {
+        kept->next = current;
+        current->prev = kept;
+        size_ -= count;
+        if (count > 0) {
+            resetCheckpoints(false);
+        }
+        while (dropped != nullptr) {
+            NodeBase* next = dropped->next;
+            discard(dropped);
+            dropped = next;
+        }
+        if (nodes != nullptr) {
+            nodes->deallocate(freed);
+        }
+    };
+    try {
+        while (current != last) {
+            NodeBase* next = current->next;
+            if (drop(current, kept)) {
+                if constexpr (freeAtOnce) {
+                    discard(current);
+                }
+                else {
+                    current->next = dropped;
+                    dropped = current;
+                }
+                ++count;
+            }
+            else {
+                if (current->prev != kept) {
+                    kept->next = current;
+                    current->prev = kept;
+                }
+                kept = current;
+            }
+            current = next;
+        }
+    }
+    catch (...) {
+        close();
+        throw;
+    }
+    close();
+    return count;
+}
+
+// move the whole chain hanging off sentinel from onto sentinel to
+template <typename T, std::size_t N>
+void MyList<T, N>::relink(NodeBase& to, NodeBase& from) {
+    if (from.next == &from) {
+        to.prev = &to;
+        to.next = &to;
         return;
     }
-    if (position.current_ == tail) {
-        position.current_->prev->next = position.current_->next;
-        position.current_->next->prev = position.current_->prev;
-        tail = position.current_->prev;
+    to.prev = from.prev;
+    to.next = from.next;
+    to.prev->next = &to;
+    to.next->prev = &to;
+    from.prev = &from;
+    from.next = &from;
+}
 
+// before nodes move from other into this list, make both lists draw from
+// the same pool so neither can release blocks the other still uses
+template <typename T, std::size_t N>
+void MyList<T, N>::sharePool(MyList& other) {
+    if (&other == this || other.pool_ == nullptr) {
+        return;
     }
-    else if (position.current_ == head) {
-        position.current_->next->prev = position.current_->prev;
-        head = position.current_->next;
+    std::shared_ptr<Pool> theirs = Pool::root(other.pool_);
+    if (pool_ == nullptr) {
+        pool_ = theirs;
     }
-    else if (position.current_ != head) {
-        position.current_->prev->next = position.current_->next;
-        position.current_->next->prev = position.current_->prev;
+    else {
+        pool_ = Pool::root(pool_);
+        Pool::merge(pool_, *theirs);
     }
+    other.pool_ = pool_;
+}
 
-    delete position.current_;
-    size_--;
+template <typename T, std::size_t N>
+void MyList<T, N>::destroy(NodeBase* node) {
+    if (inline_.owns(static_cast<Node*>(node))) {
+        inline_.destroy(static_cast<Node*>(node));
+    }
+    else {
+        pool().destroy(static_cast<Node*>(node));
+    }
 }
 
-template <typename T>
-typename MyList<T>::Iterator MyList<T>::begin() {
-    return Iterator(head);
+// rebuild node, which sits in from's slots, in this list's storage and in
+// the same place in its chain; returns the new node
+template <typename T, std::size_t N>
+typename MyList<T, N>::NodeBase* MyList<T, N>::relocate(NodeBase* node, InlineNodes<Node, N>& from) {
+    Node* old = static_cast<Node*>(node);
+    Node* moved = inline_.create(node->prev, node->next, std::move(old->data));
+    if (moved == nullptr) {
+        moved = pool().create(node->prev, node->next, std::move(old->data));
+    }
+    node->prev->next = moved;
+    node->next->prev = moved;
+    if (compactAt_ == node) {
+        compactAt_ = moved;
+    }
+    from.destroy(old);
+    resetCheckpoints(false);
+    return moved;
 }
 
-template <typename T>
-typename MyList<T>::Iterator MyList<T>::end() {
+// rebuild the nodes of [first, last) that sit in from's slots in this
+// list's storage; the range may be in either list's chain.  first may be
+// replaced, last is left alone.
+template <typename T, std::size_t N>
+void MyList<T, N>::adopt(MyList& from, NodeBase* first, NodeBase* last) {
+    if (from.inline_.empty()) {
+        return;
+    }
+    for (NodeBase* current = first; current != last; current = current->next) {
+        if (from.inline_.owns(static_cast<Node*>(current))) {
+            current = relocate(current, from.inline_);
+        }
+    }
+}
 
-    tail->next = endnode;
-    endnode->prev = tail;
-    endnode->next = nullptr;
-    return Iterator(endnode);
+// move [first, last) in front of position
+template <typename T, std::size_t N>
+void MyList<T, N>::transfer(NodeBase* position, NodeBase* first, NodeBase* last) {
+    if (first == last) {
+        return;
+    }
+    NodeBase* before = first->prev;
+    NodeBase* lastMoved = last->prev;
+    before->next = last;
+    last->prev = before;
+    first->prev = position->prev;
+    lastMoved->next = position;
+    position->prev->next = first;
+    position->prev = lastMoved;
 }
 
+// rebuild node from the new pool in the same place in the list
+template <typename T, std::size_t N>
+void MyList<T, N>::moveNode(NodeBase* node) {
+    resetCheckpoints(false);
+    Node* moved = pool_->create(node->prev, node->next, std::move(static_cast<Node*>(node)->data));
+    node->prev->next = moved;
+    node->next->prev = moved;
+    compactFrom_ = Pool::root(compactFrom_);
+    compactFrom_->destroy(static_cast<Node*>(node));
+}
 
+// every node has left the old pool; it is freed here unless another list
+// still draws from it
+template <typename T, std::size_t N>
+void MyList<T, N>::finishCompaction() {
+    compactFrom_.reset();
+    compactAt_ = nullptr;
+}
 
-#endif // MY_LIST_HPP_
+// end a compaction early by folding the old pool into the new one, so
+// that every node is owned by pool_ again
+template <typename T, std::size_t N>
+void MyList<T, N>::settle() {
+    if (compactFrom_ == nullptr) {
+        return;
+    }
+    std::shared_ptr<Pool> from = Pool::root(compactFrom_);
+    pool_ = Pool::root(pool_);
+    Pool::merge(pool_, *from);
+    finishCompaction();
+}
+
+// record every checkpointStride_-th appended node; at maxCheckpoints keep
+// every other one and double the stride
+template <typename T, std::size_t N>
+void MyList<T, N>::noteAppended(NodeBase* node) {
+    if (!checkpointsValid_ || ++sinceCheckpoint_ < checkpointStride_) {
+        return;
+    }
+    sinceCheckpoint_ = 0;
+    checkpoints_.push_back(node);
+    if (checkpoints_.size() == maxCheckpoints) {
+        for (std::size_t i = 1; i < maxCheckpoints; i += 2) {
+            checkpoints_[i / 2] = checkpoints_[i];
+        }
+        checkpoints_.resize(maxCheckpoints / 2);
+        checkpointStride_ *= 2;
+    }
+}
+
+template <typename T, std::size_t N>
+void MyList<T, N>::resetCheckpoints(bool valid) const {
+    checkpoints_.clear();
+    checkpointStride_ = minCheckpointStride;
+    sinceCheckpoint_ = 0;
+    checkpointsValid_ = valid;
+}
+
+// one walk over the links, taking the same spacing appends would have
+template <typename T, std::size_t N>
+void MyList<T, N>::rebuildCheckpoints() const {
+    resetCheckpoints(true);
+    while (static_cast<std::size_t>(size_ / checkpointStride_) >= maxCheckpoints) {
+        checkpointStride_ *= 2;
+    }
+    int index = 0;
+    for (NodeBase* current = endnode.next; current != &endnode; current = current->next) {
+        if (++index % checkpointStride_ == 0) {
+            checkpoints_.push_back(current);
+        }
+    }
+    sinceCheckpoint_ = index % checkpointStride_;
+}
+
+// Visit nodes in order until visit returns true, and return that node (or
+// end).  lead runs distance nodes ahead of the node being visited and is
+// prefetched as it goes.  size_ bounds every loop, so the steady part needs
+// no end checks and is unrolled by four.  walk only reads the links;
+// whether the elements may be written is up to the caller.
+template <typename T, std::size_t N>
+template <typename Visit>
+typename MyList<T, N>::NodeBase* MyList<T, N>::walk(Visit visit, int distance) const {
+    NodeBase* current = endnode.next;
+    NodeBase* lead = current;
+    int ahead = distance < 0 ? 0 : (distance < size_ ? distance : size_);
+    for (int i = 0; i < ahead; ++i) {
+        prefetch(lead);
+        lead = lead->next;
+    }
+    int steady = size_ - ahead;
+    int i = 0;
+    for (; i + 4 <= steady; i += 4) {
+        for (int k = 0; k < 4; ++k) {
+            prefetch(lead);
+            lead = lead->next;
+            if (visit(current)) {
+                return current;
+            }
+            current = current->next;
+        }
+    }
+    for (; i < steady; ++i) {
+        prefetch(lead);
+        lead = lead->next;
+        if (visit(current)) {
+            return current;
+        }
+        current = current->next;
+    }
+    for (; current != &endnode; current = current->next) {
+        if (visit(current)) {
+            return current;
+        }
+    }
+    return current;
+}
 
+// bring in the element of node: the node itself when T is inline, the
+// payload slot when the layout is split
+template <typename T, std::size_t N>
+void MyList<T, N>::prefetch(const NodeBase* node) {
+#if defined(__GNUC__)
+    __builtin_prefetch(&static_cast<const Node*>(node)->data);
+#else
+    (void)node;
+#endif
+}
 
+// Runs are kept as null-terminated singly linked chains while sorting.
+// bins[i] is either empty or a sorted run of 2^i nodes; each node taken off
+// the chain carries into the bins like a binary counter.  Higher bins hold
+// earlier elements, so they always go on the left of a merge, which keeps
+// the sort stable.
+template <typename T, std::size_t N>
+template <typename Compare>
+typename MyList<T, N>::NodeBase* MyList<T, N>::sortChain(NodeBase* chain, Compare& comp) {
+    NodeBase* bins[64] = {};
+    int fill = 0;
+    while (chain != nullptr) {
+        NodeBase* run = chain;
+        chain = chain->next;
+        run->next = nullptr;
+        int i = 0;
+        for (; i < fill && bins[i] != nullptr; ++i) {
+            run = mergeRuns(bins[i], run, comp);
+            bins[i] = nullptr;
+        }
+        if (i == fill) {
+            ++fill;
+        }
+        bins[i] = run;
+    }
+    NodeBase* sorted = nullptr;
+    for (int i = 0; i < fill; ++i) {
+        if (bins[i] != nullptr) {
+            sorted = sorted == nullptr ? bins[i] : mergeRuns(bins[i], sorted, comp);
+        }
+    }
+    return sorted;
+}
 
+// hang the null-terminated chain sorted back off the sentinel, rebuilding
+// the prev links in one pass
+template <typename T, std::size_t N>
+void MyList<T, N>::relinkSorted(NodeBase* sorted) {
+    NodeBase* prev = &endnode;
+    for (NodeBase* current = sorted; current != nullptr; current = current->next) {
+        current->prev = prev;
+        prev = current;
+    }
+    endnode.next = sorted;
+    endnode.prev = prev;
+    prev->next = &endnode;
+}
 
+// merge two sorted null-terminated runs; ties go to a, so the merge is
+// stable
+template <typename T, std::size_t N>
+template <typename Compare>
+typename MyList<T, N>::NodeBase* MyList<T, N>::mergeRuns(NodeBase* a, NodeBase* b, Compare& comp) {
+    NodeBase head;
+    NodeBase* tail = &head;
+    while (a != nullptr && b != nullptr) {
+        if (comp(static_cast<Node*>(b)->data, static_cast<Node*>(a)->data)) {
+            tail->next = b;
+            b = b->next;
+        }
+        else {
+            tail->next = a;
+            a = a->next;
+        }
+        tail = tail->next;
+    }
+    tail->next = a != nullptr ? a : b;
+    return head.next;
+}
 
+#endif // MY_LIST_HPP_
@@ -0,0 +1,467 @@
+#ifndef NODE_POOL_HPP_
+#define NODE_POOL_HPP_
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+// Slab allocator for fixed-size list nodes.
+// Nodes are carved out of large blocks that are chained together through a
+// small header at the front of each block.  A freed node goes onto an
+// intrusive free list and is handed out again before the current block is
+// touched, so steady push/pop churn never reaches malloc.  release() gives
+// all blocks back in one pass over the block chain, without visiting nodes.
+//
+// Two pools can be merged: the survivor takes over the other's blocks and
+// free slots, and the emptied pool forwards to the survivor.  Lists that
+// move nodes between each other merge their pools this way, so a node is
+// always owned by a pool that every list holding it keeps alive.
+template <typename Node>
+class NodePool {
+ private:
+  // a slot is either a live node or a link in the free list
+  union Slot {
+    Slot* next;
+    alignas(Node) unsigned char storage[sizeof(Node)];
+  };
+
+  struct Block {
+    Block* next;
+    std::size_t capacity;
+  };
+
+  static constexpr std::size_t slotAlign =
+      alignof(Slot) > alignof(Block) ? alignof(Slot) : alignof(Block);
+  // slots start at the first properly aligned offset after the header
+  static constexpr std::size_t headerSize =
+      (sizeof(Block) + slotAlign - 1) / slotAlign * slotAlign;
+
+  static constexpr std::size_t firstBlockCapacity = 16;
+  static constexpr std::size_t maxBlockCapacity = std::size_t {1} << 16;
+
+  Block* blocks {nullptr};
+  Slot* freeList {nullptr};
+  // last slot of the free list, valid while freeList is not null
+  Slot* freeTail {nullptr};
+  // bump region of the newest block
+  Slot* cursor {nullptr};
+  Slot* limit {nullptr};
+  std::size_t nextCapacity {firstBlockCapacity};
+  // set once this pool has been merged into another
+  std::shared_ptr<NodePool> forward {};
+
+ public:
+  NodePool() = default;
+  NodePool(const NodePool&) = delete;
+  NodePool& operator=(const NodePool&) = delete;
+  ~NodePool() {
+    release();
+  }
+
+  // raw storage for one node; the caller constructs into it
+  Node* allocate() {
+    if (freeList != nullptr) {
+      Slot* slot = freeList;
+      freeList = slot->next;
+      return reinterpret_cast<Node*>(slot);
+    }
+    return allocateFresh();
+  }
+
+  // raw storage from the bump region, bypassing the free list, so that a
+  // run of calls after reserve(n) hands out adjacent slots in order
+  Node* allocateFresh() {
+    if (cursor == limit) {
+      grow();
+    }
+    return reinterpret_cast<Node*>(cursor++);
+  }
+
+  // return storage of an already destroyed node to the free list
+  void deallocate(Node* node) {
+    Slot* slot = reinterpret_cast<Slot*>(node);
+    if (freeList == nullptr) {
+      freeTail = slot;
+    }
+    slot->next = freeList;
+    freeList = slot;
+  }
+
+  // storage of destroyed nodes gathered up by destroy(node, freed), to be
+  // put on the free list by deallocate(freed) with one splice
+  class Freed {
+    friend class NodePool;
+    Slot* head {nullptr};
+    Slot* tail {nullptr};
+
+   public:
+    void add(Node* node) {
+      Slot* slot = reinterpret_cast<Slot*>(node);
+      if (head == nullptr) {
+        tail = slot;
+      }
+      slot->next = head;
+      head = slot;
+    }
+  };
+
+  void deallocate(Freed& freed) {
+    if (freed.head == nullptr) {
+      return;
+    }
+    if (freeList == nullptr) {
+      freeTail = freed.tail;
+    }
+    freed.tail->next = freeList;
+    freeList = freed.head;
+    freed.head = nullptr;
+    freed.tail = nullptr;
+  }
+
+  template <typename... Args>
+  Node* create(Args&&... args) {
+    Node* node = allocate();
+    try {
+      return ::new (static_cast<void*>(node)) Node(std::forward<Args>(args)...);
+    } catch (...) {
+      deallocate(node);
+      throw;
+    }
+  }
+
+  // create() from allocateFresh()
+  template <typename... Args>
+  Node* createFresh(Args&&... args) {
+    Node* node = allocateFresh();
+    try {
+      return ::new (static_cast<void*>(node)) Node(std::forward<Args>(args)...);
+    } catch (...) {
+      deallocate(node);
+      throw;
+    }
+  }
+
+  void destroy(Node* node) {
+    node->~Node();
+    deallocate(node);
+  }
+
+  void destroy(Node* node, Freed& freed) {
+    node->~Node();
+    freed.add(node);
+  }
+
+  // free every block at once.  Nodes still carved out of the pool must
+  // already have been destroyed (or be trivially destructible).
+  void release() {
+    while (blocks != nullptr) {
+      Block* next = blocks->next;
+      ::operator delete(static_cast<void*>(blocks), std::align_val_t {slotAlign});
+      blocks = next;
+    }
+    freeList = nullptr;
+    freeTail = nullptr;
+    cursor = nullptr;
+    limit = nullptr;
+    nextCapacity = firstBlockCapacity;
+  }
+
+  bool forwarded() const {
+    return forward != nullptr;
+  }
+
+  // the pool that pool has (transitively) been merged into, or pool itself
+  static std::shared_ptr<NodePool> root(std::shared_ptr<NodePool> pool) {
+    while (pool->forward != nullptr) {
+      pool = pool->forward;
+    }
+    return pool;
+  }
+
+  // move every block and free slot of from into into, and make from
+  // forward to into.  Both must be roots.  Costs O(blocks of from).
+  static void merge(const std::shared_ptr<NodePool>& into, NodePool& from) {
+    if (into.get() == &from) {
+      return;
+    }
+    into->absorb(from);
+    from.forward = into;
+  }
+
+  // take over every block and free slot of from, leaving it empty
+  void absorb(NodePool& from) {
+    if (&from == this) {
+      return;
+    }
+    if (from.blocks != nullptr) {
+      Block* last = from.blocks;
+      while (last->next != nullptr) {
+        last = last->next;
+      }
+      last->next = blocks;
+      blocks = from.blocks;
+    }
+    if (from.freeList != nullptr) {
+      from.freeTail->next = freeList;
+      if (freeList == nullptr) {
+        freeTail = from.freeTail;
+      }
+      freeList = from.freeList;
+    }
+    if (cursor == limit) {
+      // our bump region is spent; carry on from from's instead
+      cursor = from.cursor;
+      limit = from.limit;
+    }
+    from.blocks = nullptr;
+    from.freeList = nullptr;
+    from.freeTail = nullptr;
+    from.cursor = nullptr;
+    from.limit = nullptr;
+  }
+
+  // number of blocks currently held
+  std::size_t blockCount() const {
+    std::size_t count = 0;
+    for (Block* b = blocks; b != nullptr; b = b->next) {
+      ++count;
+    }
+    return count;
+  }
+
+  // make the next n allocations that miss the free list come from one
+  // contiguous run of slots
+  void reserve(std::size_t n) {
+    if (static_cast<std::size_t>(limit - cursor) < n) {
+      grow(n);
+    }
+  }
+
+  // whether node lies in one of this pool's blocks; O(blocks)
+  bool owns(const Node* node) const {
+    auto address = reinterpret_cast<const unsigned char*>(node);
+    for (Block* b = blocks; b != nullptr; b = b->next) {
+      auto first = reinterpret_cast<const unsigned char*>(b) + headerSize;
+      if (address >= first && address < first + b->capacity * sizeof(Slot)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+ private:
+  void grow() {
+    grow(nextCapacity);
+    if (nextCapacity < maxBlockCapacity) {
+      nextCapacity *= 2;
+    }
+  }
+
+  void grow(std::size_t capacity) {
+    void* raw = ::operator new(headerSize + capacity * sizeof(Slot),
+                               std::align_val_t {slotAlign});
+    Block* block = static_cast<Block*>(raw);
+    block->next = blocks;
+    block->capacity = capacity;
+    blocks = block;
+    cursor = reinterpret_cast<Slot*>(static_cast<unsigned char*>(raw) + headerSize);
+    limit = cursor + capacity;
+  }
+};
+
+// Pool for nodes whose payload lives apart from the links (see
+// ListLayout).  Nodes come from one slab pool and payload slots from
+// another, so a walk that only follows links stays within the densely
+// packed node slab.  Node is constructed with its payload slot in front of
+// the other arguments, and must expose the payload as a T& named data.
+// Merging and forwarding work as for NodePool.
+template <typename Node, typename T>
+class SplitNodePool {
+ private:
+  struct Payload {
+    alignas(T) unsigned char storage[sizeof(T)];
+  };
+
+  NodePool<Node> links {};
+  NodePool<Payload> payloads {};
+  std::shared_ptr<SplitNodePool> forward {};
+
+ public:
+  struct Freed {
+    typename NodePool<Node>::Freed links {};
+    typename NodePool<Payload>::Freed payloads {};
+  };
+
+  SplitNodePool() = default;
+  SplitNodePool(const SplitNodePool&) = delete;
+  SplitNodePool& operator=(const SplitNodePool&) = delete;
+
+  template <typename... Args>
+  Node* create(Args&&... args) {
+    Payload* payload = payloads.allocate();
+    try {
+      return links.create(static_cast<void*>(payload), std::forward<Args>(args)...);
+    } catch (...) {
+      payloads.deallocate(payload);
+      throw;
+    }
+  }
+
+  template <typename... Args>
+  Node* createFresh(Args&&... args) {
+    Payload* payload = payloads.allocateFresh();
+    try {
+      return links.createFresh(static_cast<void*>(payload), std::forward<Args>(args)...);
+    } catch (...) {
+      payloads.deallocate(payload);
+      throw;
+    }
+  }
+
+  void destroy(Node* node) {
+    Payload* payload = reinterpret_cast<Payload*>(&node->data);
+    links.destroy(node);
+    payloads.deallocate(payload);
+  }
+
+  void destroy(Node* node, Freed& freed) {
+    Payload* payload = reinterpret_cast<Payload*>(&node->data);
+    links.destroy(node, freed.links);
+    freed.payloads.add(payload);
+  }
+
+  void deallocate(Freed& freed) {
+    links.deallocate(freed.links);
+    payloads.deallocate(freed.payloads);
+  }
+
+  void release() {
+    links.release();
+    payloads.release();
+  }
+
+  bool forwarded() const {
+    return forward != nullptr;
+  }
+
+  static std::shared_ptr<SplitNodePool> root(std::shared_ptr<SplitNodePool> pool) {
+    while (pool->forward != nullptr) {
+      pool = pool->forward;
+    }
+    return pool;
+  }
+
+  static void merge(const std::shared_ptr<SplitNodePool>& into, SplitNodePool& from) {
+    if (into.get() == &from) {
+      return;
+    }
+    into->links.absorb(from.links);
+    into->payloads.absorb(from.payloads);
+    from.forward = into;
+  }
+
+  void reserve(std::size_t n) {
+    links.reserve(n);
+    payloads.reserve(n);
+  }
+
+  bool owns(const Node* node) const {
+    return links.owns(node);
+  }
+
+  // blocks held for nodes and for payloads together
+  std::size_t blockCount() const {
+    return links.blockCount() + payloads.blockCount();
+  }
+};
+
+// Fixed room for up to N nodes inside the object that holds it, for lists
+// that are usually short.  A bit per slot marks it taken; create() returns
+// null once every slot is taken, and the caller falls back to its pool.
+// The slots cannot be handed to anyone else, so a node in them must be
+// moved out before it may leave its list.
+template <typename Node, std::size_t N>
+class InlineNodes {
+  static_assert(N <= 64, "one bit per slot in a 64-bit mask");
+
+ private:
+  struct Slot {
+    alignas(Node) unsigned char storage[sizeof(Node)];
+  };
+
+  Slot slots[N];
+  std::uint64_t taken {0};
+
+ public:
+  InlineNodes() = default;
+  InlineNodes(const InlineNodes&) = delete;
+  InlineNodes& operator=(const InlineNodes&) = delete;
+
+  template <typename... Args>
+  Node* create(Args&&... args) {
+    if (full()) {
+      return nullptr;
+    }
+    int slot = std::countr_one(taken);
+    Node* node = ::new (static_cast<void*>(slots[slot].storage)) Node(std::forward<Args>(args)...);
+    taken |= std::uint64_t {1} << slot;
+    return node;
+  }
+
+  void destroy(Node* node) {
+    auto slot = reinterpret_cast<Slot*>(node) - slots;
+    node->~Node();
+    taken &= ~(std::uint64_t {1} << slot);
+  }
+
+  bool owns(const Node* node) const {
+    auto address = reinterpret_cast<const unsigned char*>(node);
+    auto first = reinterpret_cast<const unsigned char*>(slots);
+    return address >= first && address < first + sizeof(slots);
+  }
+
+  bool empty() const {
+    return taken == 0;
+  }
+
+  std::size_t available() const {
+    return N - static_cast<std::size_t>(std::popcount(taken));
+  }
+
+  bool full() const {
+    return taken == (N == 64 ? ~std::uint64_t {0} : (std::uint64_t {1} << N % 64) - 1);
+  }
+};
+
+// no inline room: every node comes from the pool, at no cost in size
+template <typename Node>
+class InlineNodes<Node, 0> {
+ public:
+  template <typename... Args>
+  Node* create(Args&&...) {
+    return nullptr;
+  }
+
+  void destroy(Node*) {}
+
+  bool owns(const Node*) const {
+    return false;
+  }
+
+  bool empty() const {
+    return true;
+  }
+
+  std::size_t available() const {
+    return 0;
+  }
+
+  bool full() const {
+    return true;
+  }
+};
+
+#endif    // NODE_POOL_HPP_
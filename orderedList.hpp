@@ -0,0 +1,445 @@
+#ifndef ORDERED_LIST_HPP_
+#define ORDERED_LIST_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include "myList.hpp"
+
+// MyList with order-maintenance labels, for asking in O(1) whether one
+// position comes before another (Dietz & Sleator's two-level scheme).
+// Every element carries an integer label that grows along the list, so
+// before(a, b) compares two numbers instead of walking from a to b.
+//
+// Labels are kept in two levels.  Elements belong to groups of at most
+// groupCapacity consecutive elements and are labelled within their group;
+// a full group is split in two and its elements relabelled, O(group).
+// Groups are labelled in a list of their own, and a new group that finds
+// no free label between its neighbours relabels the smallest enclosing
+// range of group labels that is sparse enough (Bender et al.'s density
+// thresholds), which is amortised O(log n) group labels.  Only one element
+// insert in groupCapacity / 2 creates a group, so insert and erase are
+// amortised O(1).  before() compares group labels and, within a group,
+// element labels.
+//
+// Iterators are MyList positions underneath: inserting never invalidates
+// one, and erasing invalidates only the erased element's.
+//
+// Labels are LabelBits wide.  With the default of 62 the group labels do
+// not run out before memory does; narrower ones run out sooner (at 16
+// bits, after about a hundred groups), and insert then throws
+// std::length_error, leaving the list as it was.
+template <typename T, int LabelBits = 62>
+class OrderedList {
+private:
+    struct Group;
+    struct Entry;
+    using Base = MyList<Entry>;
+    using Position = typename Base::Iterator;
+    using Groups = MyList<Group>;
+    using GroupPosition = typename Groups::Iterator;
+
+    static_assert(LabelBits >= 16 && LabelBits <= 62, "labels must fit a uint64_t and leave room for a full group");
+
+    // labels of both levels lie in [1, labelLimit); end() is labelLimit
+    static constexpr std::uint64_t labelLimit = std::uint64_t{ 1 } << LabelBits;
+    // room left behind a label appended at the end of its level, so that a
+    // run of appends does not halve the space each time
+    static constexpr std::uint64_t appendGap = std::uint64_t{ 1 } << (LabelBits / 2 + 1);
+    static constexpr int groupCapacity = 64;
+    // a range of 2^i group labels may hold up to (2 / density)^i groups
+    static constexpr double density = 1.5;
+
+    struct Group {
+        std::uint64_t label{ 0 };
+        int count{ 0 };
+        Position first{};
+    };
+
+    struct Entry {
+        T value;
+        GroupPosition group{};
+        std::uint64_t label{ 0 };
+        template <typename... Args>
+        explicit Entry(std::in_place_t, Args&&... args) : value(std::forward<Args>(args)...) {}
+    };
+
+public:
+    class Iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        Position current_{};
+
+        Iterator() = default;
+        explicit Iterator(Position position) : current_(position) {}
+
+        Iterator& operator++() {
+            ++current_;
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator old = *this;
+            ++current_;
+            return old;
+        }
+
+        Iterator& operator--() {
+            --current_;
+            return *this;
+        }
+
+        Iterator operator--(int) {
+            Iterator old = *this;
+            --current_;
+            return old;
+        }
+
+        T& operator*() const {
+            return (*current_).value;
+        }
+
+        T* operator->() const {
+            return &(*current_).value;
+        }
+
+        friend bool operator==(const Iterator& a, const Iterator& b) {
+            return a.current_ == b.current_;
+        }
+
+        friend bool operator!=(const Iterator& a, const Iterator& b) {
+            return !(a == b);
+        }
+    };
+
+private:
+    Base list_;
+    Groups groups_;
+
+public:
+    OrderedList() = default;
+    OrderedList(std::initializer_list<T> vals);
+    OrderedList(const OrderedList& other);
+    OrderedList(OrderedList&& other) noexcept = default;
+    OrderedList& operator=(const OrderedList& other);
+    OrderedList& operator=(OrderedList&& other) noexcept = default;
+
+    T& front();
+    T& back();
+
+    void push_front(const T& value);
+    void pop_front();
+    void push_back(const T& value);
+    void pop_back();
+
+    Iterator insert(const Iterator& position, const T& value);
+    template <typename... Args>
+    Iterator emplace(const Iterator& position, Args&&... args);
+    void erase(const Iterator& position);
+
+    // whether a comes strictly before b; end() comes after every element
+    bool before(const Iterator& a, const Iterator& b) const;
+
+    bool empty() const;
+    int size() const;
+
+    void clear();
+
+    Iterator begin();
+    Iterator end();
+
+private:
+    void makeRoom(Position next);
+    void place(Position at);
+    void split(GroupPosition group);
+    GroupPosition insertGroupAfter(GroupPosition group);
+    void relabelGroups(GroupPosition added);
+    static void relabel(GroupPosition group);
+    static std::uint64_t between(std::uint64_t low, std::uint64_t high);
+};
+
+template <typename T, int LabelBits>
+OrderedList<T, LabelBits>::OrderedList(std::initializer_list<T> vals) {
+    for (const auto& val : vals) {
+        push_back(val);
+    }
+}
+
+// labels refer to other's groups, so the copy builds its own
+template <typename T, int LabelBits>
+OrderedList<T, LabelBits>::OrderedList(const OrderedList& other) {
+    for (const auto& entry : other.list_) {
+        push_back(entry.value);
+    }
+}
+
+template <typename T, int LabelBits>
+OrderedList<T, LabelBits>& OrderedList<T, LabelBits>::operator=(const OrderedList& other) {
+    if (this != &other) {
+        OrderedList copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+template <typename T, int LabelBits>
+T& OrderedList<T, LabelBits>::front() {
+    return list_.front().value;
+}
+
+template <typename T, int LabelBits>
+T& OrderedList<T, LabelBits>::back() {
+    return list_.back().value;
+}
+
+template <typename T, int LabelBits>
+void OrderedList<T, LabelBits>::push_front(const T& value) {
+    emplace(begin(), value);
+}
+
+template <typename T, int LabelBits>
+void OrderedList<T, LabelBits>::pop_front() {
+    if (!empty()) {
+        erase(begin());
+    }
+}
+
+template <typename T, int LabelBits>
+void OrderedList<T, LabelBits>::push_back(const T& value) {
+    emplace(end(), value);
+}
+
+template <typename T, int LabelBits>
+void OrderedList<T, LabelBits>::pop_back() {
+    if (!empty()) {
+        erase(--end());
+    }
+}
+
+template <typename T, int LabelBits>
+typename OrderedList<T, LabelBits>::Iterator OrderedList<T, LabelBits>::insert(const Iterator& position, const T& value) {
+    return emplace(position, value);
+}
+
+template <typename T, int LabelBits>
+template <typename... Args>
+typename OrderedList<T, LabelBits>::Iterator OrderedList<T, LabelBits>::emplace(const Iterator& position, Args&&... args) {
+    makeRoom(position.current_);
+    Position at = list_.emplace(position.current_, std::in_place, std::forward<Args>(args)...);
+    try {
+        place(at);
+    }
+    catch (...) {
+        list_.erase(at);
+        throw;
+    }
+    return Iterator(at);
+}
+
+template <typename T, int LabelBits>
+void OrderedList<T, LabelBits>::erase(const Iterator& position) {
+    Position at = position.current_;
+    GroupPosition group = (*at).group;
+    if (--(*group).count == 0) {
+        groups_.erase(group);
+    }
+    else if ((*group).first == at) {
+        (*group).first = std::next(at);
+    }
+    list_.erase(at);
+}
+
+template <typename T, int LabelBits>
+bool OrderedList<T, LabelBits>::before(const Iterator& a, const Iterator& b) const {
+    if (a == b || a.current_ == list_.end()) {
+        return false;
+    }
+    if (b.current_ == list_.end()) {
+        return true;
+    }
+    const Entry& x = *a.current_;
+    const Entry& y = *b.current_;
+    if (x.group != y.group) {
+        return (*x.group).label < (*y.group).label;
+    }
+    return x.label < y.label;
+}
+
+template <typename T, int LabelBits>
+bool OrderedList<T, LabelBits>::empty() const {
+    return list_.empty();
+}
+
+template <typename T, int LabelBits>
+int OrderedList<T, LabelBits>::size() const {
+    return list_.size();
+}
+
+template <typename T, int LabelBits>
+void OrderedList<T, LabelBits>::clear() {
+    list_.clear();
+    groups_.clear();
+}
+
+template <typename T, int LabelBits>
+typename OrderedList<T, LabelBits>::Iterator OrderedList<T, LabelBits>::begin() {
+    return Iterator(list_.begin());
+}
+
+template <typename T, int LabelBits>
+typename OrderedList<T, LabelBits>::Iterator OrderedList<T, LabelBits>::end() {
+    return Iterator(list_.end());
+}
+
+// A new element joins the group of the element before it, or of the one
+// after it at the front of the list.  If that group is full it is split
+// before the element is linked; either half then has room.
+template <typename T, int LabelBits>
+void OrderedList<T, LabelBits>::makeRoom(Position next) {
+    if (next == list_.begin()) {
+        if (next != list_.end() && (*(*next).group).count == groupCapacity) {
+            split((*next).group);
+        }
+        return;
+    }
+    GroupPosition group = (*std::prev(next)).group;
+    if ((*group).count == groupCapacity) {
+        split(group);
+    }
+}
+
+// give the freshly linked node at its group and a label
+template <typename T, int LabelBits>
+void OrderedList<T, LabelBits>::place(Position at) {
+    bool hasPrev = at != list_.begin();
+    Position next = std::next(at);
+    bool hasNext = next != list_.end();
+    if (!hasPrev && !hasNext) {
+        GroupPosition group = insertGroupAfter(groups_.end());
+        (*group).count = 1;
+        (*group).first = at;
+        (*at).group = group;
+        (*at).label = between(0, labelLimit);
+        return;
+    }
+    GroupPosition group = hasPrev ? (*std::prev(at)).group : (*next).group;
+    bool nextInGroup = hasNext && (*next).group == group;
+    (*at).group = group;
+    (*group).count++;
+    if (!hasPrev) {
+        (*group).first = at;
+    }
+    std::uint64_t low = hasPrev ? (*std::prev(at)).label : 0;
+    std::uint64_t high = nextInGroup ? (*next).label : labelLimit;
+    if (high - low >= 2) {
+        (*at).label = between(low, high);
+    }
+    else {
+        relabel(group);
+    }
+}
+
+// move the back half of a full group into a new group right after it
+template <typename T, int LabelBits>
+void OrderedList<T, LabelBits>::split(GroupPosition group) {
+    GroupPosition added = insertGroupAfter(group);
+    int keep = (*group).count / 2;
+    Position moved = std::next((*group).first, keep);
+    (*added).first = moved;
+    (*added).count = (*group).count - keep;
+    (*group).count = keep;
+    for (int i = 0; i < (*added).count; ++i, ++moved) {
+        (*moved).group = added;
+    }
+    relabel(group);
+    relabel(added);
+}
+
+template <typename T, int LabelBits>
+typename OrderedList<T, LabelBits>::GroupPosition OrderedList<T, LabelBits>::insertGroupAfter(GroupPosition group) {
+    GroupPosition next = group == groups_.end() ? groups_.begin() : std::next(group);
+    GroupPosition added = groups_.emplace(next);
+    std::uint64_t low = group == groups_.end() ? 0 : (*group).label;
+    std::uint64_t high = next == groups_.end() ? labelLimit : (*next).label;
+    if (high - low >= 2) {
+        (*added).label = between(low, high);
+    }
+    else {
+        try {
+            relabelGroups(added);
+        }
+        catch (...) {
+            groups_.erase(added);
+            throw;
+        }
+    }
+    return added;
+}
+
+// added has just been linked after a group whose label has no successor
+// free.  Widen an aligned range of labels around it, 2^i at a time, until
+// the groups inside are few enough for the range, then spread them evenly
+// over it.
+template <typename T, int LabelBits>
+void OrderedList<T, LabelBits>::relabelGroups(GroupPosition added) {
+    GroupPosition from = std::prev(added);
+    GroupPosition to = std::next(added);
+    std::uint64_t anchor = (*from).label;
+    std::size_t count = 2;
+    for (int i = 1; i <= LabelBits; ++i) {
+        std::uint64_t width = std::uint64_t{ 1 } << i;
+        std::uint64_t low = anchor & ~(width - 1);
+        std::uint64_t high = low + width;
+        while (from != groups_.begin() && (*std::prev(from)).label >= low) {
+            --from;
+            ++count;
+        }
+        while (to != groups_.end() && (*to).label < high) {
+            ++to;
+            ++count;
+        }
+        if (static_cast<double>(count) * std::pow(density, i) <= static_cast<double>(width)) {
+            // low may be 0, which is not a label
+            std::uint64_t step = width / (count + 1);
+            std::uint64_t label = low;
+            for (GroupPosition g = from; g != to; ++g) {
+                label += step;
+                (*g).label = label;
+            }
+            return;
+        }
+    }
+    throw std::length_error("OrderedList: out of group labels");
+}
+
+// spread a group's labels evenly over the whole label space
+template <typename T, int LabelBits>
+void OrderedList<T, LabelBits>::relabel(GroupPosition group) {
+    std::uint64_t step = labelLimit / static_cast<std::uint64_t>((*group).count + 1);
+    Position at = (*group).first;
+    for (int i = 1; i <= (*group).count; ++i, ++at) {
+        (*at).label = step * static_cast<std::uint64_t>(i);
+    }
+}
+
+// a label strictly between low and high, which are at least 2 apart.  At
+// the end of a level it stays close to low, leaving room for more appends.
+template <typename T, int LabelBits>
+std::uint64_t OrderedList<T, LabelBits>::between(std::uint64_t low, std::uint64_t high) {
+    std::uint64_t step = (high - low) / 2;
+    if (high == labelLimit && step > appendGap) {
+        step = appendGap;
+    }
+    return low + step;
+}
+
+#endif // ORDERED_LIST_HPP_
@@ -0,0 +1,57 @@
+#ifndef PARALLEL_LIST_HPP_
+#define PARALLEL_LIST_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <vector>
+#include "myList.hpp"
+#include "threadPool.hpp"
+
+// Data-parallel walks and sorting over a MyList.  The list is cut at its split points
+// into one run per thread (the pool's workers plus the caller) and each run
+// is walked by one task, so nothing is shared between tasks but the
+// elements they were given.  The list must not be modified while a walk is
+// in progress.
+
+// f(element) for every element, in no particular order across runs
+template <typename T, std::size_t N, typename F>
+void parallel_for_each(ThreadPool& pool, MyList<T, N>& list, F f) {
+    auto points = list.split_points(pool.size() + 1);
+    pool.run(static_cast<int>(points.size()) - 1, [&](int i) {
+        for (auto it = points[i]; it != points[i + 1]; ++it) {
+            f(*it);
+        }
+    });
+}
+
+// reduce(... reduce(reduce(init, transform(e0)), transform(e1)) ...) with
+// the brackets moved: each run is reduced on its own, starting from its
+// first element, and the run results are folded into init in list order.
+// reduce must be associative; it need not be commutative.
+template <typename T, std::size_t N, typename U, typename Reduce, typename Transform = std::identity>
+U parallel_reduce(ThreadPool& pool, const MyList<T, N>& list, U init, Reduce reduce, Transform transform = {}) {
+    auto points = list.split_points(pool.size() + 1);
+    std::vector<std::optional<U>> partial(points.size() - 1);
+    pool.run(static_cast<int>(partial.size()), [&](int i) {
+        auto it = points[i];
+        U acc = transform(*it);
+        for (++it; it != points[i + 1]; ++it) {
+            acc = reduce(std::move(acc), transform(*it));
+        }
+        partial[i].emplace(std::move(acc));
+    });
+    for (auto& run : partial) {
+        init = reduce(std::move(init), std::move(*run));
+    }
+    return init;
+}
+
+// MyList::sort spread over the pool's threads and the caller; comp is
+// called from several threads at once and must not throw
+template <typename T, std::size_t N, typename Compare = std::less<>>
+void parallel_sort(ThreadPool& pool, MyList<T, N>& list, Compare comp = {}) {
+    list.sort(comp, pool.size() + 1, [&](int tasks, auto f) { pool.run(tasks, f); });
+}
+
+#endif // PARALLEL_LIST_HPP_
@@ -0,0 +1,261 @@
+#ifndef PERSISTENT_LIST_HPP_
+#define PERSISTENT_LIST_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+// Immutable singly linked list whose versions share structure.
+// push_front and pop_front leave the list they are called on untouched and
+// return a new version that shares every node behind its front, so a copy
+// (a snapshot) is one reference count increment, whatever the length.
+//
+// Nodes are never modified after construction and carry an atomic
+// reference count, so versions sharing nodes may be used and dropped on
+// different threads without further locking.  A single PersistentList
+// object is an ordinary value, though: assigning to one that another
+// thread is reading needs the caller's own synchronisation.
+template <typename T>
+class PersistentList {
+public:
+    struct Node {
+        mutable std::atomic<int> refs{ 1 };
+        const T data;
+        const Node* next;
+        template <typename... Args>
+        explicit Node(const Node* tail, Args&&... args) : data(std::forward<Args>(args)...), next(tail) {}
+    };
+
+    class ConstIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const Node* current_{ nullptr };
+
+        ConstIterator() = default;
+        explicit ConstIterator(const Node* node) : current_(node) {}
+
+        ConstIterator& operator++() {
+            current_ = current_->next;
+            return *this;
+        }
+
+        ConstIterator operator++(int) {
+            ConstIterator old = *this;
+            current_ = current_->next;
+            return old;
+        }
+
+        reference operator*() const {
+            return current_->data;
+        }
+
+        pointer operator->() const {
+            return &current_->data;
+        }
+
+        friend bool operator==(const ConstIterator& a, const ConstIterator& b) {
+            return a.current_ == b.current_;
+        }
+
+        friend bool operator!=(const ConstIterator& a, const ConstIterator& b) {
+            return !(a == b);
+        }
+    };
+
+    using Iterator = ConstIterator;
+
+private:
+    const Node* head_{ nullptr };
+    int size_{ 0 };
+
+    PersistentList(const Node* head, int size) : head_(head), size_(size) {}
+
+public:
+    PersistentList() = default;
+    PersistentList(std::initializer_list<T> vals);
+    // build from [first, last), keeping its order; O(n) once, after which
+    // every snapshot is O(1)
+    template <typename InputIt>
+    PersistentList(InputIt first, InputIt last);
+    // a snapshot: shares every node
+    PersistentList(const PersistentList& other);
+    PersistentList(PersistentList&& other) noexcept;
+    PersistentList& operator=(const PersistentList& other);
+    PersistentList& operator=(PersistentList&& other) noexcept;
+    ~PersistentList();
+
+    // new versions; this list is unchanged
+    PersistentList push_front(const T& value) const;
+    PersistentList push_front(T&& value) const;
+    template <typename... Args>
+    PersistentList emplace_front(Args&&... args) const;
+    // the list without its first element; empty stays empty
+    PersistentList pop_front() const;
+
+    const T& front() const;
+    bool empty() const;
+    int size() const;
+    // whether the two lists are the same version, not just equal
+    bool shares(const PersistentList& other) const;
+
+    ConstIterator begin() const;
+    ConstIterator end() const;
+    ConstIterator cbegin() const;
+    ConstIterator cend() const;
+
+private:
+    static const Node* retain(const Node* node);
+    static void release(const Node* node);
+};
+
+template <typename T>
+PersistentList<T>::PersistentList(std::initializer_list<T> vals) : PersistentList(vals.begin(), vals.end()) {}
+
+// nodes are appended through a pointer to the last next link, which is
+// only written before the node is shared
+template <typename T>
+template <typename InputIt>
+PersistentList<T>::PersistentList(InputIt first, InputIt last) {
+    const Node** tail = &head_;
+    try {
+        for (; first != last; ++first) {
+            Node* node = new Node(nullptr, *first);
+            *tail = node;
+            tail = &node->next;
+            ++size_;
+        }
+    }
+    catch (...) {
+        release(head_);
+        throw;
+    }
+}
+
+template <typename T>
+PersistentList<T>::PersistentList(const PersistentList& other) : head_(retain(other.head_)), size_(other.size_) {}
+
+template <typename T>
+PersistentList<T>::PersistentList(PersistentList&& other) noexcept : head_(other.head_), size_(other.size_) {
+    other.head_ = nullptr;
+    other.size_ = 0;
+}
+
+template <typename T>
+PersistentList<T>& PersistentList<T>::operator=(const PersistentList& other) {
+    const Node* old = head_;
+    head_ = retain(other.head_);
+    size_ = other.size_;
+    release(old);
+    return *this;
+}
+
+template <typename T>
+PersistentList<T>& PersistentList<T>::operator=(PersistentList&& other) noexcept {
+    std::swap(head_, other.head_);
+    std::swap(size_, other.size_);
+    return *this;
+}
+
+template <typename T>
+PersistentList<T>::~PersistentList() {
+    release(head_);
+}
+
+template <typename T>
+PersistentList<T> PersistentList<T>::push_front(const T& value) const {
+    return emplace_front(value);
+}
+
+template <typename T>
+PersistentList<T> PersistentList<T>::push_front(T&& value) const {
+    return emplace_front(std::move(value));
+}
+
+// the new node holds the reference to the old head
+template <typename T>
+template <typename... Args>
+PersistentList<T> PersistentList<T>::emplace_front(Args&&... args) const {
+    const Node* node = new Node(head_, std::forward<Args>(args)...);
+    retain(head_);
+    return PersistentList(node, size_ + 1);
+}
+
+template <typename T>
+PersistentList<T> PersistentList<T>::pop_front() const {
+    if (head_ == nullptr) {
+        return PersistentList();
+    }
+    return PersistentList(retain(head_->next), size_ - 1);
+}
+
+template <typename T>
+const T& PersistentList<T>::front() const {
+    return head_->data;
+}
+
+template <typename T>
+bool PersistentList<T>::empty() const {
+    return head_ == nullptr;
+}
+
+template <typename T>
+int PersistentList<T>::size() const {
+    return size_;
+}
+
+template <typename T>
+bool PersistentList<T>::shares(const PersistentList& other) const {
+    return head_ == other.head_;
+}
+
+template <typename T>
+typename PersistentList<T>::ConstIterator PersistentList<T>::begin() const {
+    return ConstIterator(head_);
+}
+
+template <typename T>
+typename PersistentList<T>::ConstIterator PersistentList<T>::end() const {
+    return ConstIterator(nullptr);
+}
+
+template <typename T>
+typename PersistentList<T>::ConstIterator PersistentList<T>::cbegin() const {
+    return begin();
+}
+
+template <typename T>
+typename PersistentList<T>::ConstIterator PersistentList<T>::cend() const {
+    return end();
+}
+
+// a new reference can only be taken through one already held, so relaxed
+// is enough here
+template <typename T>
+const typename PersistentList<T>::Node* PersistentList<T>::retain(const Node* node) {
+    if (node != nullptr) {
+        node->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    return node;
+}
+
+// Dropping the last reference to a node drops its reference to the next
+// one.  This is a loop rather than a recursion, so freeing a long unshared
+// chain cannot overflow the stack.  acq_rel makes every other thread's use
+// of a node happen before the thread that frees it.
+template <typename T>
+void PersistentList<T>::release(const Node* node) {
+    while (node != nullptr && node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        const Node* next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
+#endif // PERSISTENT_LIST_HPP_
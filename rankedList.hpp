@@ -0,0 +1,426 @@
+#ifndef RANKED_LIST_HPP_
+#define RANKED_LIST_HPP_
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include "myList.hpp"
+
+// MyList with an indexable skip list on top, for seeking by position.
+// The elements sit in a MyList, which is level 0 of the skip list.  A node
+// also gets h express lanes above it with probability (1/4)^h; each lane
+// link records its width, the number of level-0 steps it skips.  That
+// makes at(k), advance(it, k) and index_of(it) expected O(log n), and
+// insert/erase stay expected O(log n) because they only fix the lanes of
+// one node and the widths of the links passing over it.
+//
+// Iterators are MyList positions underneath: inserting never invalidates
+// one, and erasing invalidates only the erased element's.
+template <typename T>
+class RankedList {
+private:
+    struct Entry;
+    using Base = MyList<Entry>;
+    // a node of the underlying MyList; default constructed it stands for
+    // the skip list's head, which comes before the first element
+    using Position = typename Base::Iterator;
+
+    static constexpr int maxLevels = 15;
+
+    struct Lane {
+        Position prev{};
+        Position next{};
+        // level-0 steps from this node to next (to one past the last
+        // element when next is the head)
+        int width{ 0 };
+    };
+
+    struct Entry {
+        T value;
+        int height;
+        std::unique_ptr<Lane[]> lanes;
+        template <typename... Args>
+        Entry(int laneCount, Args&&... args)
+            : value(std::forward<Args>(args)...), height{ laneCount },
+              lanes{ laneCount > 0 ? new Lane[laneCount] : nullptr } {}
+    };
+
+public:
+    class Iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        Position current_{};
+
+        Iterator() = default;
+        explicit Iterator(Position position) : current_(position) {}
+
+        Iterator& operator++() {
+            ++current_;
+            return *this;
+        }
+
+        Iterator& operator--() {
+            --current_;
+            return *this;
+        }
+
+        T& operator*() const {
+            return (*current_).value;
+        }
+
+        T* operator->() const {
+            return &(*current_).value;
+        }
+
+        friend bool operator==(const Iterator& a, const Iterator& b) {
+            return a.current_ == b.current_;
+        }
+
+        friend bool operator!=(const Iterator& a, const Iterator& b) {
+            return !(a == b);
+        }
+    };
+
+private:
+    Base list_;
+    // lanes leaving the head, one per level in use
+    Lane head_[maxLevels];
+    int levels_;
+    std::minstd_rand rng_;
+
+public:
+    RankedList();
+    RankedList(std::initializer_list<T> vals);
+    RankedList(const RankedList& other);
+    RankedList(RankedList&& other) noexcept;
+    RankedList& operator=(const RankedList& other);
+    RankedList& operator=(RankedList&& other) noexcept;
+
+    T& front();
+    T& back();
+
+    void push_front(const T& value);
+    void pop_front();
+    void push_back(const T& value);
+    void pop_back();
+
+    Iterator insert(const Iterator& position, const T& value);
+    template <typename... Args>
+    Iterator emplace(const Iterator& position, Args&&... args);
+    void erase(const Iterator& position);
+
+    // element at 0-based position k; throws std::out_of_range
+    T& at(int k);
+    // the iterator k places after it (before it for negative k)
+    Iterator advance(const Iterator& it, int k);
+    // 0-based position of it; size() for end()
+    int index_of(const Iterator& it);
+
+    bool empty() const;
+    int size() const;
+
+    void clear();
+
+    Iterator begin();
+    Iterator end();
+
+private:
+    bool isHead(const Position& x) const;
+    Lane& lane(const Position& x, int level);
+    Position previous(Position x);
+    int rankOf(const Position& x);
+    Position seek(int rank, Position update[], int updateRank[]);
+    int randomHeight();
+};
+
+template <typename T>
+RankedList<T>::RankedList() : levels_{ 0 }, rng_{ 12345 } {}
+
+template <typename T>
+RankedList<T>::RankedList(std::initializer_list<T> vals) : RankedList() {
+    for (const auto& val : vals) {
+        push_back(val);
+    }
+}
+
+// lanes point into other's nodes, so the copy builds its own
+template <typename T>
+RankedList<T>::RankedList(const RankedList& other) : RankedList() {
+    for (const auto& entry : other.list_) {
+        push_back(entry.value);
+    }
+}
+
+// nodes keep their addresses when the MyList moves, so the lanes carry over
+template <typename T>
+RankedList<T>::RankedList(RankedList&& other) noexcept
+    : list_{ std::move(other.list_) }, levels_{ other.levels_ }, rng_{ other.rng_ } {
+    for (int l = 0; l < levels_; ++l) {
+        head_[l] = other.head_[l];
+    }
+    other.levels_ = 0;
+}
+
+template <typename T>
+RankedList<T>& RankedList<T>::operator=(const RankedList& other) {
+    if (this != &other) {
+        RankedList copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+template <typename T>
+RankedList<T>& RankedList<T>::operator=(RankedList&& other) noexcept {
+    if (this != &other) {
+        list_ = std::move(other.list_);
+        other.list_.clear();
+        levels_ = other.levels_;
+        for (int l = 0; l < levels_; ++l) {
+            head_[l] = other.head_[l];
+        }
+        other.levels_ = 0;
+    }
+    return *this;
+}
+
+template <typename T>
+T& RankedList<T>::front() {
+    return list_.front().value;
+}
+
+template <typename T>
+T& RankedList<T>::back() {
+    return list_.back().value;
+}
+
+template <typename T>
+void RankedList<T>::push_front(const T& value) {
+    emplace(begin(), value);
+}
+
+template <typename T>
+void RankedList<T>::pop_front() {
+    if (!empty()) {
+        erase(begin());
+    }
+}
+
+template <typename T>
+void RankedList<T>::push_back(const T& value) {
+    emplace(end(), value);
+}
+
+template <typename T>
+void RankedList<T>::pop_back() {
+    if (!empty()) {
+        erase(--end());
+    }
+}
+
+template <typename T>
+typename RankedList<T>::Iterator RankedList<T>::insert(const Iterator& position, const T& value) {
+    return emplace(position, value);
+}
+
+template <typename T>
+template <typename... Args>
+typename RankedList<T>::Iterator RankedList<T>::emplace(const Iterator& position, Args&&... args) {
+    // the new element takes the rank of the one it goes in front of
+    int rank = rankOf(position.current_);
+    Position update[maxLevels];
+    int updateRank[maxLevels];
+    seek(rank - 1, update, updateRank);
+
+    int height = randomHeight();
+    for (; levels_ < height; ++levels_) {
+        head_[levels_] = Lane{ Position{}, Position{}, size() + 1 };
+        update[levels_] = Position{};
+        updateRank[levels_] = 0;
+    }
+
+    Position node = list_.emplace(position.current_, height, std::forward<Args>(args)...);
+    for (int l = 0; l < levels_; ++l) {
+        Lane& before = lane(update[l], l);
+        if (l < height) {
+            Lane& mine = (*node).lanes[l];
+            mine.prev = update[l];
+            mine.next = before.next;
+            mine.width = before.width - (rank - updateRank[l]) + 1;
+            if (!isHead(before.next)) {
+                lane(before.next, l).prev = node;
+            }
+            before.next = node;
+            before.width = rank - updateRank[l];
+        }
+        else {
+            before.width++;
+        }
+    }
+    return Iterator(node);
+}
+
+template <typename T>
+void RankedList<T>::erase(const Iterator& position) {
+    int rank = rankOf(position.current_);
+    Position update[maxLevels];
+    int updateRank[maxLevels];
+    seek(rank - 1, update, updateRank);
+
+    Entry& entry = *position.current_;
+    for (int l = 0; l < levels_; ++l) {
+        Lane& before = lane(update[l], l);
+        if (l < entry.height) {
+            Lane& mine = entry.lanes[l];
+            before.width += mine.width - 1;
+            before.next = mine.next;
+            if (!isHead(mine.next)) {
+                lane(mine.next, l).prev = update[l];
+            }
+        }
+        else {
+            before.width--;
+        }
+    }
+    list_.erase(position.current_);
+    while (levels_ > 0 && isHead(head_[levels_ - 1].next)) {
+        --levels_;
+    }
+}
+
+template <typename T>
+T& RankedList<T>::at(int k) {
+    if (k < 0 || k >= size()) {
+        throw std::out_of_range("RankedList::at");
+    }
+    Position update[maxLevels];
+    int updateRank[maxLevels];
+    return (*seek(k + 1, update, updateRank)).value;
+}
+
+template <typename T>
+typename RankedList<T>::Iterator RankedList<T>::advance(const Iterator& it, int k) {
+    int rank = rankOf(it.current_) + k;
+    if (rank == size() + 1) {
+        return end();
+    }
+    if (rank < 1 || rank > size()) {
+        throw std::out_of_range("RankedList::advance");
+    }
+    Position update[maxLevels];
+    int updateRank[maxLevels];
+    return Iterator(seek(rank, update, updateRank));
+}
+
+template <typename T>
+int RankedList<T>::index_of(const Iterator& it) {
+    return rankOf(it.current_) - 1;
+}
+
+template <typename T>
+bool RankedList<T>::empty() const {
+    return list_.empty();
+}
+
+template <typename T>
+int RankedList<T>::size() const {
+    return list_.size();
+}
+
+template <typename T>
+void RankedList<T>::clear() {
+    list_.clear();
+    levels_ = 0;
+}
+
+template <typename T>
+typename RankedList<T>::Iterator RankedList<T>::begin() {
+    return Iterator(list_.begin());
+}
+
+template <typename T>
+typename RankedList<T>::Iterator RankedList<T>::end() {
+    return Iterator(list_.end());
+}
+
+template <typename T>
+bool RankedList<T>::isHead(const Position& x) const {
+    return x.current_ == nullptr;
+}
+
+template <typename T>
+typename RankedList<T>::Lane& RankedList<T>::lane(const Position& x, int level) {
+    return isHead(x) ? head_[level] : (*x).lanes[level];
+}
+
+// the level-0 predecessor, or the head for the first element
+template <typename T>
+typename RankedList<T>::Position RankedList<T>::previous(Position x) {
+    --x;
+    return x == list_.end() ? Position{} : x;
+}
+
+// 1-based rank of x (size() + 1 for end), found by climbing backwards:
+// from a node with lanes, jump back along its top lane, otherwise step
+// back one node, adding up widths until the head is reached
+template <typename T>
+int RankedList<T>::rankOf(const Position& x) {
+    if (x == list_.end()) {
+        return size() + 1;
+    }
+    int rank = 0;
+    Position current = x;
+    while (!isHead(current)) {
+        int height = (*current).height;
+        if (height > 0) {
+            Position back = (*current).lanes[height - 1].prev;
+            rank += lane(back, height - 1).width;
+            current = back;
+        }
+        else {
+            rank += 1;
+            current = previous(current);
+        }
+    }
+    return rank;
+}
+
+// walk down from the top lane to the node of the given rank (the head for
+// rank 0), recording the last node visited on each lane and its rank
+template <typename T>
+typename RankedList<T>::Position RankedList<T>::seek(int rank, Position update[], int updateRank[]) {
+    Position current{};
+    int at = 0;
+    for (int l = levels_ - 1; l >= 0; --l) {
+        for (Lane* step = &lane(current, l); !isHead(step->next) && at + step->width <= rank; step = &lane(current, l)) {
+            at += step->width;
+            current = step->next;
+        }
+        update[l] = current;
+        updateRank[l] = at;
+    }
+    for (; at < rank; ++at) {
+        current = isHead(current) ? list_.begin() : ++current;
+    }
+    return current;
+}
+
+template <typename T>
+int RankedList<T>::randomHeight() {
+    int height = 0;
+    for (auto bits = rng_(); height < maxLevels && (bits & 3) == 0; bits >>= 2) {
+        ++height;
+    }
+    return height;
+}
+
+#endif // RANKED_LIST_HPP_
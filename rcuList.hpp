@@ -0,0 +1,289 @@
+#ifndef RCU_LIST_HPP_
+#define RCU_LIST_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include "epochDomain.hpp"
+
+// Read-mostly doubly linked list for one writer and any number of readers
+// (read-copy-update).  Readers go forward only, through next links that
+// the writer publishes with a single release store, so a reader sees each
+// element either before or after a change but never a half-linked node.
+// prev links are for the writer alone.
+//
+// A reader holds a View, which pins the EpochDomain: no lock is taken and
+// nothing shared is written.  Elements are never modified in place;
+// replace() links in a new node instead.  An unlinked node is retired and
+// freed only once every View that might still be standing on it is gone.
+//
+// Writer calls must not overlap each other: with more than one writer
+// thread, serialise them with a mutex of their own.
+template <typename T>
+class RcuList {
+public:
+    struct NodeBase {
+        std::atomic<NodeBase*> next{ nullptr };
+        NodeBase* prev{ nullptr };
+    };
+
+    struct Node : NodeBase {
+        const T data;
+        template <typename... Args>
+        explicit Node(Args&&... args) : data(std::forward<Args>(args)...) {}
+    };
+
+    // the reader's iterator: forward only, over a pinned list
+    class ConstIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const NodeBase* current_{ nullptr };
+
+        ConstIterator() = default;
+        explicit ConstIterator(const NodeBase* node) : current_(node) {}
+
+        ConstIterator& operator++() {
+            current_ = current_->next.load(std::memory_order_acquire);
+            return *this;
+        }
+
+        ConstIterator operator++(int) {
+            ConstIterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        reference operator*() const {
+            return static_cast<const Node*>(current_)->data;
+        }
+
+        pointer operator->() const {
+            return &**this;
+        }
+
+        friend bool operator==(const ConstIterator& a, const ConstIterator& b) {
+            return a.current_ == b.current_;
+        }
+
+        friend bool operator!=(const ConstIterator& a, const ConstIterator& b) {
+            return !(a == b);
+        }
+    };
+
+    // a reader's pinned window onto the list; keep it short-lived, since
+    // nothing erased while it exists can be freed
+    class View {
+    public:
+        explicit View(const RcuList& list) : list_(&list) {}
+
+        ConstIterator begin() const {
+            return ConstIterator(list_->endnode.next.load(std::memory_order_acquire));
+        }
+
+        ConstIterator end() const {
+            return ConstIterator(&list_->endnode);
+        }
+
+    private:
+        EpochDomain::Guard guard_;
+        const RcuList* list_;
+    };
+
+    // the writer's position; stays valid until the writer erases it
+    using Iterator = ConstIterator;
+
+private:
+    NodeBase endnode;
+
+    std::atomic<int> size_;
+
+public:
+    RcuList();
+    RcuList(const RcuList&) = delete;
+    RcuList& operator=(const RcuList&) = delete;
+    // no reader may be using the list any more
+    ~RcuList();
+
+    // readers
+    View read() const;
+    template <typename F>
+    void for_each(F f) const;
+    // current element count; may be stale by the time a reader uses it
+    int size() const;
+    bool empty() const;
+
+    // writer
+    void push_front(const T& value);
+    void push_back(const T& value);
+    void pop_front();
+    void pop_back();
+    Iterator insert(const Iterator& position, const T& value);
+    template <typename... Args>
+    Iterator emplace(const Iterator& position, Args&&... args);
+    void erase(const Iterator& position);
+    // swap a new element in for the one at position; readers see one or the other
+    Iterator replace(const Iterator& position, const T& value);
+    void clear();
+
+    // writer-side iteration, without pinning
+    Iterator begin() const;
+    Iterator end() const;
+
+private:
+    static NodeBase* mutableNode(const Iterator& it);
+    void unlink(NodeBase* node);
+};
+
+template <typename T>
+RcuList<T>::RcuList() : size_{ 0 } {
+    endnode.next.store(&endnode, std::memory_order_relaxed);
+    endnode.prev = &endnode;
+}
+
+template <typename T>
+RcuList<T>::~RcuList() {
+    NodeBase* current = endnode.next.load(std::memory_order_relaxed);
+    while (current != &endnode) {
+        NodeBase* next = current->next.load(std::memory_order_relaxed);
+        delete static_cast<Node*>(current);
+        current = next;
+    }
+}
+
+template <typename T>
+typename RcuList<T>::View RcuList<T>::read() const {
+    return View(*this);
+}
+
+template <typename T>
+template <typename F>
+void RcuList<T>::for_each(F f) const {
+    View view(*this);
+    for (const T& value : view) {
+        f(value);
+    }
+}
+
+template <typename T>
+int RcuList<T>::size() const {
+    return size_.load(std::memory_order_relaxed);
+}
+
+template <typename T>
+bool RcuList<T>::empty() const {
+    return size() == 0;
+}
+
+template <typename T>
+void RcuList<T>::push_front(const T& value) {
+    emplace(begin(), value);
+}
+
+template <typename T>
+void RcuList<T>::push_back(const T& value) {
+    emplace(end(), value);
+}
+
+template <typename T>
+void RcuList<T>::pop_front() {
+    if (!empty()) {
+        erase(begin());
+    }
+}
+
+template <typename T>
+void RcuList<T>::pop_back() {
+    if (!empty()) {
+        unlink(endnode.prev);
+    }
+}
+
+template <typename T>
+typename RcuList<T>::Iterator RcuList<T>::insert(const Iterator& position, const T& value) {
+    return emplace(position, value);
+}
+
+// the node is complete before the release store makes it reachable
+template <typename T>
+template <typename... Args>
+typename RcuList<T>::Iterator RcuList<T>::emplace(const Iterator& position, Args&&... args) {
+    NodeBase* next = mutableNode(position);
+    NodeBase* prev = next->prev;
+    Node* node = new Node(std::forward<Args>(args)...);
+    node->prev = prev;
+    node->next.store(next, std::memory_order_relaxed);
+    prev->next.store(node, std::memory_order_release);
+    next->prev = node;
+    size_.store(size_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    return Iterator(node);
+}
+
+template <typename T>
+void RcuList<T>::erase(const Iterator& position) {
+    unlink(mutableNode(position));
+}
+
+template <typename T>
+typename RcuList<T>::Iterator RcuList<T>::replace(const Iterator& position, const T& value) {
+    NodeBase* old = mutableNode(position);
+    NodeBase* next = old->next.load(std::memory_order_relaxed);
+    Node* node = new Node(value);
+    node->prev = old->prev;
+    node->next.store(next, std::memory_order_relaxed);
+    old->prev->next.store(node, std::memory_order_release);
+    next->prev = node;
+    EpochDomain::Guard guard;
+    EpochDomain::instance().retire(static_cast<Node*>(old));
+    return Iterator(node);
+}
+
+// readers still on the old chain keep walking it; every node is retired
+template <typename T>
+void RcuList<T>::clear() {
+    NodeBase* current = endnode.next.load(std::memory_order_relaxed);
+    endnode.next.store(&endnode, std::memory_order_release);
+    endnode.prev = &endnode;
+    size_.store(0, std::memory_order_relaxed);
+    EpochDomain::Guard guard;
+    while (current != &endnode) {
+        NodeBase* next = current->next.load(std::memory_order_relaxed);
+        EpochDomain::instance().retire(static_cast<Node*>(current));
+        current = next;
+    }
+}
+
+template <typename T>
+typename RcuList<T>::Iterator RcuList<T>::begin() const {
+    return Iterator(endnode.next.load(std::memory_order_relaxed));
+}
+
+template <typename T>
+typename RcuList<T>::Iterator RcuList<T>::end() const {
+    return Iterator(&endnode);
+}
+
+// the writer owns every node, so its positions may be written through
+template <typename T>
+typename RcuList<T>::NodeBase* RcuList<T>::mutableNode(const Iterator& it) {
+    return const_cast<NodeBase*>(it.current_);
+}
+
+// the node's own next is left alone, so a reader standing on it carries on
+// into the rest of the list
+template <typename T>
+void RcuList<T>::unlink(NodeBase* node) {
+    NodeBase* next = node->next.load(std::memory_order_relaxed);
+    node->prev->next.store(next, std::memory_order_release);
+    next->prev = node->prev;
+    size_.store(size_.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+    EpochDomain::Guard guard;
+    EpochDomain::instance().retire(static_cast<Node*>(node));
+}
+
+#endif // RCU_LIST_HPP_
@@ -0,0 +1,141 @@
+#ifndef THREAD_POOL_HPP_
+#define THREAD_POOL_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for fork-join work over a list.
+// run(tasks, f) hands f(0) ... f(tasks - 1) to the workers and returns once
+// every call has finished; the calling thread takes tasks too, so a pool of
+// n threads keeps n + 1 busy and run() may be called from inside a task.
+// The first exception thrown by a task is rethrown from run() after the
+// rest have finished.
+class ThreadPool {
+public:
+    explicit ThreadPool(int threads);
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    // lets queued tasks finish, then joins the workers
+    ~ThreadPool();
+
+    // worker threads, not counting callers of run()
+    int size() const;
+
+    template <typename F>
+    void run(int tasks, F f);
+
+private:
+    // one run() call, shared by the tasks it queued
+    struct Batch {
+        int pending{ 0 };
+        std::exception_ptr error;
+        std::condition_variable done;
+    };
+
+    struct Task {
+        std::function<void()> call;
+        Batch* batch;
+    };
+
+    std::vector<std::thread> workers_;
+    std::deque<Task> tasks_;
+    std::mutex lock_;
+    std::condition_variable wake_;
+    bool stopping_{ false };
+
+    void work();
+    // runs the task with lock_ released; held must own lock_ on entry and exit
+    void execute(Task task, std::unique_lock<std::mutex>& held);
+};
+
+inline ThreadPool::ThreadPool(int threads) {
+    workers_.reserve(static_cast<std::size_t>(threads));
+    for (int i = 0; i < threads; ++i) {
+        workers_.emplace_back([this] { work(); });
+    }
+}
+
+inline ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+inline int ThreadPool::size() const {
+    return static_cast<int>(workers_.size());
+}
+
+template <typename F>
+void ThreadPool::run(int tasks, F f) {
+    if (tasks <= 0) {
+        return;
+    }
+    Batch batch;
+    std::unique_lock<std::mutex> held(lock_);
+    batch.pending = tasks;
+    // task 0 is kept for this thread
+    for (int i = 1; i < tasks; ++i) {
+        tasks_.push_back(Task{ [&f, i] { f(i); }, &batch });
+    }
+    wake_.notify_all();
+    execute(Task{ [&f] { f(0); }, &batch }, held);
+    // help with whatever is queued instead of just waiting for it
+    while (batch.pending > 0) {
+        if (!tasks_.empty()) {
+            Task task = std::move(tasks_.front());
+            tasks_.pop_front();
+            execute(std::move(task), held);
+        }
+        else {
+            batch.done.wait(held);
+        }
+    }
+    if (batch.error) {
+        std::rethrow_exception(batch.error);
+    }
+}
+
+inline void ThreadPool::work() {
+    std::unique_lock<std::mutex> held(lock_);
+    for (;;) {
+        wake_.wait(held, [this] { return stopping_ || !tasks_.empty(); });
+        if (tasks_.empty()) {
+            return;
+        }
+        Task task = std::move(tasks_.front());
+        tasks_.pop_front();
+        execute(std::move(task), held);
+    }
+}
+
+inline void ThreadPool::execute(Task task, std::unique_lock<std::mutex>& held) {
+    held.unlock();
+    std::exception_ptr error;
+    try {
+        task.call();
+    }
+    catch (...) {
+        error = std::current_exception();
+    }
+    held.lock();
+    Batch& batch = *task.batch;
+    if (error && !batch.error) {
+        batch.error = error;
+    }
+    if (--batch.pending == 0) {
+        batch.done.notify_all();
+    }
+}
+
+#endif // THREAD_POOL_HPP_
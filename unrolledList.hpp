@@ -0,0 +1,384 @@
+#ifndef UNROLLED_LIST_HPP_
+#define UNROLLED_LIST_HPP_
+
+#include <initializer_list>
+#include <new>
+#include <utility>
+#include "nodePool.hpp"
+
+// Doubly linked list that packs up to K elements into each node.
+// Walking the list touches one node per K elements, so a range-for loop
+// reads several elements from each cache line instead of chasing one
+// pointer per element.  The surface mirrors MyList, but because elements
+// shift inside their node, insert and erase invalidate iterators into the
+// node(s) they touch; both return an iterator to use instead.
+template <typename T, int K = 16>
+class UnrolledList {
+    static_assert(K >= 2, "an unrolled node must hold at least two elements");
+
+public:
+    // links and fill count; the sentinel is a bare NodeBase with count 0
+    struct NodeBase {
+        NodeBase* prev{ nullptr };
+        NodeBase* next{ nullptr };
+        int count{ 0 };
+    };
+
+    struct Node : NodeBase {
+        // items[0, count) are alive, the rest is raw storage
+        union {
+            T items[K];
+        };
+        Node() {}
+        ~Node() {}
+    };
+
+    class Iterator {
+    public:
+        NodeBase* current_;
+        int index_;
+        Iterator(NodeBase* node, int index) : current_(node), index_(index) {}
+
+        Iterator& operator++() {
+            if (++index_ == current_->count) {
+                current_ = current_->next;
+                index_ = 0;
+            }
+            return *this;
+        }
+
+        Iterator& operator--() {
+            if (index_ == 0) {
+                current_ = current_->prev;
+                index_ = current_->count;
+            }
+            --index_;
+            return *this;
+        }
+
+        T& operator*() const {
+            return static_cast<Node*>(current_)->items[index_];
+        }
+
+        T* operator->() const {
+            return &**this;
+        }
+
+        friend bool operator==(const Iterator& a, const Iterator& b) {
+            return a.current_ == b.current_ && a.index_ == b.index_;
+        }
+
+        friend bool operator!=(const Iterator& a, const Iterator& b) {
+            return !(a == b);
+        }
+    };
+
+private:
+    NodeBase sentinel;
+    int size_;
+    NodePool<Node> pool_;
+
+public:
+    UnrolledList();
+    UnrolledList(std::initializer_list<T> vals);
+    UnrolledList(const UnrolledList& other);
+    UnrolledList& operator=(const UnrolledList& other);
+    ~UnrolledList();
+
+    T& front();
+    const T& front() const;
+    T& back();
+    const T& back() const;
+
+    void push_front(const T& value);
+    void pop_front();
+    void push_back(const T& value);
+    void pop_back();
+
+    Iterator insert(const Iterator& position, const T& value);
+    Iterator erase(const Iterator& position);
+
+    bool empty() const;
+    int size() const;
+    // number of nodes in use, for measuring fill
+    int nodeCount() const;
+
+    void clear();
+
+    Iterator begin();
+    Iterator end();
+
+private:
+    Node* link(NodeBase* before);
+    void unlink(Node* node);
+    Iterator insertSplit(Node* node, int index, const T& value);
+};
+
+template <typename T, int K>
+UnrolledList<T, K>::UnrolledList() : size_{ 0 } {
+    sentinel.prev = &sentinel;
+    sentinel.next = &sentinel;
+}
+
+template <typename T, int K>
+UnrolledList<T, K>::UnrolledList(std::initializer_list<T> vals) : UnrolledList() {
+    for (const auto& val : vals) {
+        push_back(val);
+    }
+}
+
+template <typename T, int K>
+UnrolledList<T, K>::UnrolledList(const UnrolledList& other) : UnrolledList() {
+    for (const NodeBase* node = other.sentinel.next; node != &other.sentinel; node = node->next) {
+        for (int i = 0; i < node->count; ++i) {
+            push_back(static_cast<const Node*>(node)->items[i]);
+        }
+    }
+}
+
+template <typename T, int K>
+UnrolledList<T, K>& UnrolledList<T, K>::operator=(const UnrolledList& other) {
+    if (this != &other) {
+        clear();
+        for (const NodeBase* node = other.sentinel.next; node != &other.sentinel; node = node->next) {
+            for (int i = 0; i < node->count; ++i) {
+                push_back(static_cast<const Node*>(node)->items[i]);
+            }
+        }
+    }
+    return *this;
+}
+
+template <typename T, int K>
+UnrolledList<T, K>::~UnrolledList() {
+    clear();
+}
+
+template <typename T, int K>
+T& UnrolledList<T, K>::front() {
+    return static_cast<Node*>(sentinel.next)->items[0];
+}
+
+template <typename T, int K>
+const T& UnrolledList<T, K>::front() const {
+    return static_cast<const Node*>(sentinel.next)->items[0];
+}
+
+template <typename T, int K>
+T& UnrolledList<T, K>::back() {
+    return static_cast<Node*>(sentinel.prev)->items[sentinel.prev->count - 1];
+}
+
+template <typename T, int K>
+const T& UnrolledList<T, K>::back() const {
+    return static_cast<const Node*>(sentinel.prev)->items[sentinel.prev->count - 1];
+}
+
+template <typename T, int K>
+void UnrolledList<T, K>::push_front(const T& value) {
+    insert(begin(), value);
+}
+
+template <typename T, int K>
+void UnrolledList<T, K>::pop_front() {
+    if (size_ > 0) {
+        erase(begin());
+    }
+}
+
+template <typename T, int K>
+void UnrolledList<T, K>::push_back(const T& value) {
+    NodeBase* last = sentinel.prev;
+    if (last != &sentinel && last->count < K) {
+        ::new (static_cast<void*>(&static_cast<Node*>(last)->items[last->count])) T(value);
+        ++last->count;
+        ++size_;
+        return;
+    }
+    Node* node = link(last);
+    try {
+        ::new (static_cast<void*>(&node->items[0])) T(value);
+    } catch (...) {
+        unlink(node);
+        throw;
+    }
+    node->count = 1;
+    ++size_;
+}
+
+template <typename T, int K>
+void UnrolledList<T, K>::pop_back() {
+    if (size_ > 0) {
+        erase(--end());
+    }
+}
+
+template <typename T, int K>
+bool UnrolledList<T, K>::empty() const {
+    return size_ == 0;
+}
+
+template <typename T, int K>
+int UnrolledList<T, K>::size() const {
+    return size_;
+}
+
+template <typename T, int K>
+int UnrolledList<T, K>::nodeCount() const {
+    int count = 0;
+    for (const NodeBase* node = sentinel.next; node != &sentinel; node = node->next) {
+        ++count;
+    }
+    return count;
+}
+
+template <typename T, int K>
+void UnrolledList<T, K>::clear() {
+    for (NodeBase* node = sentinel.next; node != &sentinel; node = node->next) {
+        Node* full = static_cast<Node*>(node);
+        for (int i = 0; i < full->count; ++i) {
+            full->items[i].~T();
+        }
+    }
+    pool_.release();
+    sentinel.prev = &sentinel;
+    sentinel.next = &sentinel;
+    size_ = 0;
+}
+
+template <typename T, int K>
+typename UnrolledList<T, K>::Iterator UnrolledList<T, K>::insert(const Iterator& position, const T& value) {
+    NodeBase* node = position.current_;
+    int index = position.index_;
+
+    if (node == &sentinel) {
+        push_back(value);
+        return Iterator(sentinel.prev, sentinel.prev->count - 1);
+    }
+
+    if (node->count == K && index == 0) {
+        // in front of a full node: use the spare room of the previous node,
+        // or start a fresh node between the two, rather than splitting
+        NodeBase* before = node->prev;
+        if (before == &sentinel || before->count == K) {
+            before = link(before);
+        }
+        ::new (static_cast<void*>(&static_cast<Node*>(before)->items[before->count])) T(value);
+        ++before->count;
+        ++size_;
+        return Iterator(before, before->count - 1);
+    }
+
+    if (node->count == K) {
+        return insertSplit(static_cast<Node*>(node), index, value);
+    }
+
+    // room in this node: open a gap at index by shifting the tail up one slot
+    T* items = static_cast<Node*>(node)->items;
+    int count = node->count;
+    if (index == count) {
+        ::new (static_cast<void*>(&items[count])) T(value);
+    }
+    else {
+        // value may be one of the items about to shift
+        T copy(value);
+        ::new (static_cast<void*>(&items[count])) T(std::move(items[count - 1]));
+        // the new slot is alive from here on, even if a move below throws
+        ++node->count;
+        ++size_;
+        for (int i = count - 1; i > index; --i) {
+            items[i] = std::move(items[i - 1]);
+        }
+        items[index] = std::move(copy);
+        return Iterator(node, index);
+    }
+    ++node->count;
+    ++size_;
+    return Iterator(node, index);
+}
+
+template <typename T, int K>
+typename UnrolledList<T, K>::Iterator UnrolledList<T, K>::insertSplit(Node* node, int index, const T& value) {
+    // move the upper half into a new node behind this one, then insert
+    // into whichever half now holds position index.  value may live in the
+    // upper half, so it is copied before that is moved out.
+    T copy(value);
+    Node* upper = link(node);
+    const int keep = K / 2;
+    for (int i = keep; i < K; ++i) {
+        ::new (static_cast<void*>(&upper->items[i - keep])) T(std::move(node->items[i]));
+        node->items[i].~T();
+    }
+    upper->count = K - keep;
+    node->count = keep;
+    if (index <= keep) {
+        return insert(Iterator(node, index), copy);
+    }
+    return insert(Iterator(upper, index - keep), copy);
+}
+
+template <typename T, int K>
+typename UnrolledList<T, K>::Iterator UnrolledList<T, K>::erase(const Iterator& position) {
+    Node* node = static_cast<Node*>(position.current_);
+    int index = position.index_;
+    T* items = node->items;
+    for (int i = index + 1; i < node->count; ++i) {
+        items[i - 1] = std::move(items[i]);
+    }
+    items[--node->count].~T();
+    --size_;
+
+    if (node->count == 0) {
+        NodeBase* next = node->next;
+        unlink(node);
+        return Iterator(next, 0);
+    }
+
+    // fold an under-filled node together with its successor
+    NodeBase* next = node->next;
+    if (node->count < K / 2 && next != &sentinel && node->count + next->count <= K) {
+        Node* donor = static_cast<Node*>(next);
+        for (int i = 0; i < donor->count; ++i) {
+            ::new (static_cast<void*>(&items[node->count + i])) T(std::move(donor->items[i]));
+            donor->items[i].~T();
+        }
+        node->count += donor->count;
+        donor->count = 0;
+        unlink(donor);
+    }
+
+    if (index < node->count) {
+        return Iterator(node, index);
+    }
+    return Iterator(node->next, 0);
+}
+
+template <typename T, int K>
+typename UnrolledList<T, K>::Iterator UnrolledList<T, K>::begin() {
+    return Iterator(sentinel.next, 0);
+}
+
+template <typename T, int K>
+typename UnrolledList<T, K>::Iterator UnrolledList<T, K>::end() {
+    return Iterator(&sentinel, 0);
+}
+
+// allocate an empty node and link it in after `before`
+template <typename T, int K>
+typename UnrolledList<T, K>::Node* UnrolledList<T, K>::link(NodeBase* before) {
+    Node* node = pool_.create();
+    node->prev = before;
+    node->next = before->next;
+    before->next->prev = node;
+    before->next = node;
+    return node;
+}
+
+template <typename T, int K>
+void UnrolledList<T, K>::unlink(Node* node) {
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+    pool_.destroy(node);
+}
+
+#endif // UNROLLED_LIST_HPP_